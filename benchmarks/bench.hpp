@@ -0,0 +1,225 @@
+/*
+MIT License
+
+Copyright (c) 2023 Kieran Hsieh
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+#ifndef KT_BENCH_HPP
+#define KT_BENCH_HPP
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <utility>
+#include <vector>
+
+#if defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))
+#    include <intrin.h>
+#    define KT_BENCH_HAS_CYCLES 1
+#elif(defined(__GNUC__) || defined(__clang__)) && (defined(__x86_64__) || defined(__i386__))
+#    include <x86intrin.h>
+#    define KT_BENCH_HAS_CYCLES 1
+#else
+#    define KT_BENCH_HAS_CYCLES 0
+#endif
+
+/**
+ * @brief A minimal, dependency-free benchmark harness for the runtime-facing parts of the library
+ *
+ * @details Each benchmark case is a function registered under a name. The case performs any untimed setup, then hands the
+ * body to be measured to state::run, which performs the warmup runs and timed repetitions. Every repetition runs the body
+ * state::iterations() times and records the average time (and TSC cycles where available) per call.
+ */
+namespace bench {
+    /**
+     * @brief Prevents the compiler from optimizing away the computation of a value
+     */
+    template<typename T>
+    inline void do_not_optimize(const T& value) {
+#if defined(__GNUC__) || defined(__clang__)
+        asm volatile("" : : "r,m"(value) : "memory");
+#else
+        static volatile const void* sink;
+        sink = &value;
+#endif
+    }
+
+    /**
+     * @brief Returns the current value of the cycle counter, or 0 if none is available
+     */
+    inline std::uint64_t cycles() {
+#if KT_BENCH_HAS_CYCLES
+        return __rdtsc();
+#else
+        return 0;
+#endif
+    }
+
+    /**
+     * @brief Run-wide settings, set from the command line
+     */
+    struct options {
+        size_t warmup      = 3;  /**< Untimed runs of the body before measuring */
+        size_t repetitions = 50; /**< Timed samples per case */
+        std::string filter;      /**< Only cases containing this substring are run */
+        std::string json_path;   /**< Where to write the JSON report, if non-empty */
+    };
+
+    /**
+     * @brief Summary of a finished benchmark case
+     */
+    struct result {
+        std::string name;
+        size_t iterations     = 0;
+        size_t repetitions    = 0;
+        double median_ns      = 0; /**< Median time per iteration */
+        double p99_ns         = 0; /**< 99th percentile time per iteration */
+        double min_ns         = 0;
+        double mean_ns        = 0;
+        double median_cycles  = 0; /**< Median cycles per iteration, 0 if unavailable */
+        double p99_cycles     = 0;
+        double bytes_per_iter = 0; /**< Bytes processed per iteration, used to report throughput */
+        double items_per_iter = 0; /**< Items processed per iteration, used to report throughput */
+        std::vector<std::pair<std::string, double>> counters;
+    };
+
+    /**
+     * @brief Handle given to every benchmark case to configure and run its measurement
+     */
+    class state {
+    public:
+        explicit state(const options& opts, std::string name) : opts_(opts) {
+            result_.name        = std::move(name);
+            result_.iterations  = 1;
+            result_.repetitions = opts.repetitions;
+        }
+
+        /**
+         * @brief Sets how many times the body runs per timed sample. Use this to amortize timer overhead for very short bodies.
+         */
+        void set_iterations(size_t n) { result_.iterations = n == 0 ? 1 : n; }
+
+        /**
+         * @brief Caps the number of timed samples. Use this for bodies that take long enough that the default is excessive.
+         */
+        void max_repetitions(size_t n) {
+            if(n != 0 && n < result_.repetitions) {
+                result_.repetitions = n;
+            }
+        }
+
+        /**
+         * @brief Sets the number of bytes processed by one run of the body, which enables throughput reporting
+         */
+        void set_bytes_per_iteration(double bytes) { result_.bytes_per_iter = bytes; }
+
+        /**
+         * @brief Sets the number of items, such as messages, processed by one run of the body, which enables throughput reporting
+         */
+        void set_items_per_iteration(double items) { result_.items_per_iter = items; }
+
+        /**
+         * @brief Attaches a named value to the result, such as a latency measured by the case itself
+         */
+        void counter(std::string name, double value) { result_.counters.emplace_back(std::move(name), value); }
+
+        /**
+         * @brief Returns the number of times the body runs per timed sample
+         */
+        size_t iterations() const { return result_.iterations; }
+
+        /**
+         * @brief Runs the warmup and timed repetitions of body
+         */
+        template<typename F>
+        void run(F&& body) {
+            const size_t iters = result_.iterations;
+            for(size_t w = 0; w < opts_.warmup; ++w) {
+                for(size_t i = 0; i < iters; ++i) {
+                    body();
+                }
+            }
+            ns_.clear();
+            cycles_.clear();
+            ns_.reserve(result_.repetitions);
+            cycles_.reserve(result_.repetitions);
+            for(size_t r = 0; r < result_.repetitions; ++r) {
+                const auto start    = std::chrono::steady_clock::now();
+                const auto start_cy = bench::cycles();
+                for(size_t i = 0; i < iters; ++i) {
+                    body();
+                }
+                const auto end_cy = bench::cycles();
+                const auto end    = std::chrono::steady_clock::now();
+                ns_.push_back(std::chrono::duration<double, std::nano>(end - start).count() / static_cast<double>(iters));
+                cycles_.push_back(static_cast<double>(end_cy - start_cy) / static_cast<double>(iters));
+            }
+        }
+
+        /**
+         * @brief Returns the summary of the samples collected by run
+         */
+        result finish();
+
+    private:
+        const options& opts_;
+        result result_;
+        std::vector<double> ns_;
+        std::vector<double> cycles_;
+    };
+
+    /**
+     * @brief Signature of a benchmark case
+     */
+    using case_fn = void (*)(state&);
+
+    /**
+     * @brief A named benchmark case
+     */
+    struct case_info {
+        std::string name;
+        case_fn fn;
+    };
+
+    /**
+     * @brief Returns every benchmark case registered in the program
+     */
+    inline std::vector<case_info>& registry() {
+        static std::vector<case_info> cases;
+        return cases;
+    }
+
+    /**
+     * @brief Registers a benchmark case at static initialization time
+     */
+    struct registrar {
+        registrar(std::string name, case_fn fn) { registry().push_back({ std::move(name), fn }); }
+    };
+
+    /**
+     * @brief Parses the command line, runs every matching case, and prints the report
+     *
+     * @return The process exit code
+     */
+    int run_main(int argc, char** argv);
+}
+
+#endif
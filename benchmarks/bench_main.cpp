@@ -0,0 +1,195 @@
+/*
+MIT License
+
+Copyright (c) 2023 Kieran Hsieh
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+#include "bench.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <numeric>
+
+namespace bench {
+    namespace {
+        double percentile(const std::vector<double>& sorted, double p) {
+            if(sorted.empty()) {
+                return 0;
+            }
+            const auto rank = static_cast<size_t>(std::ceil(p * static_cast<double>(sorted.size())));
+            return sorted[std::min(sorted.size(), std::max<size_t>(rank, 1)) - 1];
+        }
+
+        std::string json_escape(const std::string& str) {
+            std::string out;
+            for(const char c : str) {
+                if(c == '"' || c == '\\') {
+                    out += '\\';
+                }
+                out += c;
+            }
+            return out;
+        }
+
+        void write_json(std::FILE* file, const options& opts, const std::vector<result>& results) {
+            std::fprintf(file, "{\n  \"warmup\": %zu,\n  \"cycles_available\": %s,\n  \"benchmarks\": [", opts.warmup,
+                         KT_BENCH_HAS_CYCLES ? "true" : "false");
+            for(size_t i = 0; i < results.size(); ++i) {
+                const result& res = results[i];
+                std::fprintf(file,
+                             "%s\n    {\n      \"name\": \"%s\",\n      \"iterations\": %zu,\n      \"repetitions\": %zu,\n"
+                             "      \"median_ns\": %.3f,\n      \"p99_ns\": %.3f,\n      \"min_ns\": %.3f,\n      \"mean_ns\": %.3f,\n"
+                             "      \"median_cycles\": %.3f,\n      \"p99_cycles\": %.3f",
+                             i == 0 ? "" : ",",
+                             json_escape(res.name).c_str(),
+                             res.iterations,
+                             res.repetitions,
+                             res.median_ns,
+                             res.p99_ns,
+                             res.min_ns,
+                             res.mean_ns,
+                             res.median_cycles,
+                             res.p99_cycles);
+                if(res.bytes_per_iter > 0) {
+                    std::fprintf(file, ",\n      \"bytes_per_iteration\": %.0f,\n      \"gb_per_s\": %.3f", res.bytes_per_iter,
+                                 res.bytes_per_iter / res.median_ns);
+                }
+                if(res.items_per_iter > 0) {
+                    std::fprintf(file, ",\n      \"items_per_iteration\": %.0f,\n      \"items_per_s\": %.1f", res.items_per_iter,
+                                 res.items_per_iter * 1e9 / res.median_ns);
+                }
+                for(const auto& counter : res.counters) {
+                    std::fprintf(file, ",\n      \"%s\": %.3f", json_escape(counter.first).c_str(), counter.second);
+                }
+                std::fprintf(file, "\n    }");
+            }
+            std::fprintf(file, "\n  ]\n}\n");
+        }
+
+        void print_result(const result& res) {
+            std::printf("%-56s %12.2f %12.2f %12.1f", res.name.c_str(), res.median_ns, res.p99_ns, res.median_cycles);
+            if(res.bytes_per_iter > 0) {
+                std::printf(" %9.2f GB/s", res.bytes_per_iter / res.median_ns);
+            }
+            if(res.items_per_iter > 0) {
+                std::printf(" %9.2f M/s", res.items_per_iter * 1e3 / res.median_ns);
+            }
+            for(const auto& counter : res.counters) {
+                std::printf(" %s=%.2f", counter.first.c_str(), counter.second);
+            }
+            std::printf("\n");
+        }
+
+        bool parse_size(const char* arg, const char* flag, size_t& out) {
+            const size_t len = std::strlen(flag);
+            if(std::strncmp(arg, flag, len) != 0) {
+                return false;
+            }
+            out = std::strtoull(arg + len, nullptr, 10);
+            return true;
+        }
+
+        bool parse_string(const char* arg, const char* flag, std::string& out) {
+            const size_t len = std::strlen(flag);
+            if(std::strncmp(arg, flag, len) != 0) {
+                return false;
+            }
+            out = arg + len;
+            return true;
+        }
+    }
+
+    result state::finish() {
+        if(ns_.empty()) {
+            return result_;
+        }
+        std::sort(ns_.begin(), ns_.end());
+        std::sort(cycles_.begin(), cycles_.end());
+        result_.repetitions   = ns_.size();
+        result_.median_ns     = percentile(ns_, 0.5);
+        result_.p99_ns        = percentile(ns_, 0.99);
+        result_.min_ns        = ns_.front();
+        result_.mean_ns       = std::accumulate(ns_.begin(), ns_.end(), 0.0) / static_cast<double>(ns_.size());
+        result_.median_cycles = percentile(cycles_, 0.5);
+        result_.p99_cycles    = percentile(cycles_, 0.99);
+        return result_;
+    }
+
+    int run_main(int argc, char** argv) {
+        options opts;
+        bool list = false;
+        for(int i = 1; i < argc; ++i) {
+            const char* arg = argv[i];
+            if(std::strcmp(arg, "--list") == 0) {
+                list = true;
+            }
+            else if(!parse_size(arg, "--warmup=", opts.warmup) && !parse_size(arg, "--reps=", opts.repetitions) &&
+                    !parse_string(arg, "--filter=", opts.filter) && !parse_string(arg, "--json=", opts.json_path)) {
+                std::fprintf(stderr,
+                             "usage: %s [--list] [--filter=SUBSTRING] [--warmup=N] [--reps=N] [--json=PATH]\n",
+                             argc > 0 ? argv[0] : "bench");
+                return EXIT_FAILURE;
+            }
+        }
+        if(opts.repetitions == 0) {
+            opts.repetitions = 1;
+        }
+
+        std::vector<case_info> cases = registry();
+        std::sort(cases.begin(), cases.end(), [](const case_info& a, const case_info& b) { return a.name < b.name; });
+
+        std::vector<result> results;
+        if(!list) {
+            std::printf("%-56s %12s %12s %12s\n", "benchmark", "median ns", "p99 ns", "cycles");
+        }
+        for(const auto& bench_case : cases) {
+            if(bench_case.name.find(opts.filter) == std::string::npos) {
+                continue;
+            }
+            if(list) {
+                std::printf("%s\n", bench_case.name.c_str());
+                continue;
+            }
+            state st(opts, bench_case.name);
+            bench_case.fn(st);
+            results.push_back(st.finish());
+            print_result(results.back());
+            std::fflush(stdout);
+        }
+
+        if(!opts.json_path.empty()) {
+            std::FILE* file = std::fopen(opts.json_path.c_str(), "w");
+            if(file == nullptr) {
+                std::fprintf(stderr, "failed to open %s for writing\n", opts.json_path.c_str());
+                return EXIT_FAILURE;
+            }
+            write_json(file, opts, results);
+            std::fclose(file);
+        }
+        return EXIT_SUCCESS;
+    }
+}
+
+int main(int argc, char** argv) {
+    return bench::run_main(argc, argv);
+}
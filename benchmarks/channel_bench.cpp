@@ -0,0 +1,217 @@
+/*
+MIT License
+
+Copyright (c) 2023 Kieran Hsieh
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+#include "bench.hpp"
+
+#include <kt/channel.hpp>
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace {
+    struct order {
+        std::uint64_t id;
+        double price;
+        std::uint32_t qty;
+        std::int64_t sent_ns;
+    };
+
+    struct cancel {
+        std::uint64_t id;
+        std::int64_t sent_ns;
+    };
+
+    struct heartbeat {
+        std::int64_t sent_ns;
+    };
+
+    using messages = kt::type_list_t<order, cancel, heartbeat>;
+
+    constexpr size_t total_messages = 200'000;
+    constexpr size_t capacity       = 4096;
+    constexpr size_t max_reps       = 10;
+
+    // Latency is measured at a fixed offered rate shared by all producers, low enough that the ring stays nearly empty, so it
+    // reflects the cost of a push and drain rather than time spent queued behind a backlog
+    constexpr size_t latency_messages         = 20'000;
+    constexpr std::int64_t latency_offered_ns = 2'000;
+
+    std::int64_t now_ns() {
+        return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+    }
+
+    struct consumer_state {
+        std::uint64_t checksum         = 0;
+        std::vector<double>* latencies = nullptr;
+
+        void record(std::int64_t sent_ns) {
+            if(latencies != nullptr) {
+                latencies->push_back(static_cast<double>(now_ns() - sent_ns));
+            }
+        }
+
+        void operator()(const order& o) {
+            checksum += o.id + o.qty;
+            record(o.sent_ns);
+        }
+        void operator()(const cancel& c) {
+            checksum += c.id;
+            record(c.sent_ns);
+        }
+        void operator()(const heartbeat& h) {
+            ++checksum;
+            record(h.sent_ns);
+        }
+    };
+
+    // With a nonzero pace_ns, the producer sends one message every pace_ns and stamps each with its send time
+    template<typename PUSH>
+    void produce(size_t producer, size_t count, std::int64_t pace_ns, PUSH&& push) {
+        const std::int64_t start = pace_ns > 0 ? now_ns() : 0;
+        for(size_t i = 0; i < count; ++i) {
+            if(pace_ns > 0) {
+                const std::int64_t due = start + static_cast<std::int64_t>(i) * pace_ns;
+                while(now_ns() < due) {
+                    std::this_thread::yield();
+                }
+            }
+            const std::int64_t sent = pace_ns > 0 ? now_ns() : 0;
+            switch(i % 4) {
+            case 0:
+            case 1: push(order { producer * count + i, 100.5, static_cast<std::uint32_t>(i), sent }); break;
+            case 2: push(cancel { producer * count + i, sent }); break;
+            default: push(heartbeat { sent }); break;
+            }
+        }
+    }
+
+    void run_channel(size_t producers, size_t messages_total, std::int64_t pace_ns, consumer_state& consumer) {
+        kt::channel<messages> ch(capacity);
+        const size_t per_producer = messages_total / producers;
+        std::vector<std::thread> threads;
+        for(size_t p = 0; p < producers; ++p) {
+            threads.emplace_back([&ch, p, per_producer, pace_ns] {
+                produce(p, per_producer, pace_ns, [&ch](auto&& msg) { ch.push(msg); });
+            });
+        }
+        size_t received = 0;
+        while(received < per_producer * producers) {
+            const size_t n = ch.drain(consumer, 256);
+            if(n == 0) {
+                std::this_thread::yield();
+            }
+            received += n;
+        }
+        for(auto& t : threads) {
+            t.join();
+        }
+    }
+
+    // The pattern the channel replaces: every message boxed in a std::function behind a mutex
+    void run_mutex_deque(size_t producers, consumer_state& consumer) {
+        std::mutex mutex;
+        std::deque<std::function<void(consumer_state&)>> queue;
+        const size_t per_producer = total_messages / producers;
+        std::vector<std::thread> threads;
+        for(size_t p = 0; p < producers; ++p) {
+            threads.emplace_back([&, p] {
+                produce(p, per_producer, 0, [&](auto&& msg) {
+                    const std::lock_guard<std::mutex> lock(mutex);
+                    queue.emplace_back([msg](consumer_state& c) { c(msg); });
+                });
+            });
+        }
+        size_t received = 0;
+        std::deque<std::function<void(consumer_state&)>> batch;
+        while(received < per_producer * producers) {
+            {
+                const std::lock_guard<std::mutex> lock(mutex);
+                batch.swap(queue);
+            }
+            if(batch.empty()) {
+                std::this_thread::yield();
+            }
+            for(auto& fn : batch) {
+                fn(consumer);
+            }
+            received += batch.size();
+            batch.clear();
+        }
+        for(auto& t : threads) {
+            t.join();
+        }
+    }
+
+    template<size_t P>
+    void throughput_channel(bench::state& s) {
+        s.max_repetitions(max_reps);
+        s.set_items_per_iteration(static_cast<double>(total_messages / P * P));
+        consumer_state consumer;
+        s.run([&] { run_channel(P, total_messages, 0, consumer); });
+        bench::do_not_optimize(consumer.checksum);
+    }
+
+    template<size_t P>
+    void throughput_mutex_deque(bench::state& s) {
+        s.max_repetitions(max_reps);
+        s.set_items_per_iteration(static_cast<double>(total_messages / P * P));
+        consumer_state consumer;
+        s.run([&] { run_mutex_deque(P, consumer); });
+        bench::do_not_optimize(consumer.checksum);
+    }
+
+    template<size_t P>
+    void latency_channel(bench::state& s) {
+        s.max_repetitions(max_reps);
+        std::vector<double> latencies;
+        latencies.reserve(latency_messages * (max_reps + 4));
+        consumer_state consumer;
+        consumer.latencies = &latencies;
+        // Each producer paces itself so that together they offer one message every latency_offered_ns
+        s.run([&] { run_channel(P, latency_messages, latency_offered_ns * static_cast<std::int64_t>(P), consumer); });
+        std::sort(latencies.begin(), latencies.end());
+        s.counter("latency_median_ns", latencies[latencies.size() / 2]);
+        s.counter("latency_p99_ns", latencies[latencies.size() * 99 / 100]);
+        s.counter("offered_msgs_per_s", 1e9 / static_cast<double>(latency_offered_ns));
+    }
+
+    template<size_t... PS>
+    bool register_cases(std::index_sequence<PS...> /* producer_counts */) {
+        const auto name = [](const char* kind, size_t producers, const char* impl) {
+            return std::string("channel/") + kind + "/producers_" + (producers < 10 ? "0" : "") + std::to_string(producers) + "/" + impl;
+        };
+        ((bench::registry().push_back({ name("throughput", PS, "channel"), &throughput_channel<PS> }),
+          bench::registry().push_back({ name("throughput", PS, "mutex_deque_function"), &throughput_mutex_deque<PS> }),
+          bench::registry().push_back({ name("latency", PS, "channel"), &latency_channel<PS> })),
+         ...);
+        return true;
+    }
+
+    const bool registered = register_cases(std::index_sequence<1, 2, 4, 8, 16>());
+}
@@ -0,0 +1,86 @@
+/*
+MIT License
+
+Copyright (c) 2023 Kieran Hsieh
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+// Compile-time benchmark for the short-circuiting queries on type_list_t. The same queries over a list of handlers are evaluated either
+// with the eager folds (all_of/one_of) or with the short-circuiting variants (all_of_lazy/any_of/find_if). The trait used by the queries
+// is deliberately expensive, and only the first handler satisfies it, so the lazy variants stop after one or two instantiations.
+//
+// Time the type_list_compile_bench_eager and type_list_compile_bench_lazy targets, or compile this file with -fsyntax-only and
+// -DKT_COMPILE_BENCH_LAZY=0 or 1.
+#include <kt/type_list.hpp>
+
+#include <cstddef>
+#include <type_traits>
+
+#ifndef KT_COMPILE_BENCH_LAZY
+#    define KT_COMPILE_BENCH_LAZY 1
+#endif
+
+#ifndef KT_COMPILE_BENCH_DEPTH
+#    define KT_COMPILE_BENCH_DEPTH 256
+#endif
+
+namespace {
+    template<size_t I>
+    struct message { };
+
+    template<size_t I>
+    struct handler {
+        void operator()(message<I>) const { }
+        void operator()(message<I + 1>, int) const { }
+    };
+
+    // Instantiates DEPTH distinct class templates for every T it is asked about
+    template<typename T, size_t DEPTH>
+    struct expensive_chain : expensive_chain<kt::type_list_t<T, kt::index_t<DEPTH>>, DEPTH - 1> { };
+
+    template<typename T>
+    struct expensive_chain<T, 0> : std::true_type { };
+
+    template<typename H>
+    struct handles_first_message :
+        std::bool_constant<expensive_chain<H, KT_COMPILE_BENCH_DEPTH>::value && std::is_invocable_v<const H&, message<0>>> { };
+
+    template<typename S>
+    struct handler_list;
+
+    template<size_t... IS>
+    struct handler_list<std::index_sequence<IS...>> {
+        using type = kt::type_list_t<handler<IS>...>;
+    };
+
+    constexpr auto handlers = typename handler_list<std::make_index_sequence<64>>::type();
+}
+
+#if KT_COMPILE_BENCH_LAZY
+static_assert(handlers.any_of(kt::func<handles_first_message>));
+static_assert(!handlers.none_of(kt::func<handles_first_message>));
+static_assert(!handlers.all_of_lazy(kt::func<handles_first_message>));
+static_assert(handlers.find_if(kt::func<handles_first_message>) == 0);
+#else
+static_assert(handlers.one_of(kt::func<handles_first_message>));
+static_assert(!handlers.all_of(kt::func<handles_first_message>));
+static_assert(handlers.count_if(kt::func<handles_first_message>) == 1);
+#endif
+
+int main() { return 0; }
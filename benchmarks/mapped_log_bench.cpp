@@ -0,0 +1,156 @@
+/*
+MIT License
+
+Copyright (c) 2023 Kieran Hsieh
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+#include "bench.hpp"
+
+#include <kt/mapped_log.hpp>
+
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <string>
+
+namespace {
+    struct trade {
+        std::uint64_t id;
+        double price;
+        std::uint32_t qty;
+    };
+
+    struct quote {
+        std::uint64_t id;
+        double bid;
+        double ask;
+        double bid_size;
+        double ask_size;
+    };
+
+    using records = kt::type_list_t<trade, quote>;
+    using log_t   = kt::mapped_log<records>;
+
+    constexpr size_t record_count = 1'000'000;
+    constexpr size_t max_reps     = 10;
+
+    // Set KT_BENCH_DIR to measure a specific disk, the working directory is used otherwise
+    std::string bench_path(const char* name) {
+        const char* dir = std::getenv("KT_BENCH_DIR");
+        return (dir != nullptr ? std::string(dir) + "/" : std::string()) + name;
+    }
+
+    struct checksum {
+        double total = 0;
+        void operator()(const trade& t) { total += t.price * t.qty; }
+        void operator()(const quote& q) { total += q.ask - q.bid; }
+    };
+
+    void write_log(const std::string& path) {
+        log_t log(path, kt::log_mode::truncate);
+        for(std::uint64_t i = 0; i < record_count; ++i) {
+            if(i % 3 == 0) {
+                log.append(quote { i, 1.0, 1.5, 10, 20 });
+            }
+            else {
+                log.append(trade { i, 1.25, static_cast<std::uint32_t>(i) });
+            }
+        }
+    }
+
+    // The iostream pattern the log replaces: a type byte followed by the record, read back one field group at a time
+    void write_stream(const std::string& path) {
+        std::ofstream out(path, std::ios::binary | std::ios::trunc);
+        for(std::uint64_t i = 0; i < record_count; ++i) {
+            if(i % 3 == 0) {
+                const quote q { i, 1.0, 1.5, 10, 20 };
+                out.put(1).write(reinterpret_cast<const char*>(&q), sizeof(q));
+            }
+            else {
+                const trade t { i, 1.25, static_cast<std::uint32_t>(i) };
+                out.put(0).write(reinterpret_cast<const char*>(&t), sizeof(t));
+            }
+        }
+    }
+
+    double read_stream(const std::string& path) {
+        std::ifstream in(path, std::ios::binary);
+        checksum sum;
+        char type = 0;
+        while(in.get(type)) {
+            if(type == 1) {
+                quote q { };
+                in.read(reinterpret_cast<char*>(&q), sizeof(q));
+                sum(q);
+            }
+            else {
+                trade t { };
+                in.read(reinterpret_cast<char*>(&t), sizeof(t));
+                sum(t);
+            }
+        }
+        return sum.total;
+    }
+
+    size_t file_bytes(const std::string& path) {
+        std::ifstream in(path, std::ios::binary | std::ios::ate);
+        return static_cast<size_t>(in.tellg());
+    }
+
+    const bench::registrar log_write { "mapped_log/write_1M/mapped_log", [](bench::state& s) {
+        const std::string path = bench_path("kt_mapped_log_bench.log");
+        s.max_repetitions(max_reps);
+        s.run([&] { write_log(path); });
+        s.set_bytes_per_iteration(static_cast<double>(file_bytes(path)));
+        std::remove(path.c_str());
+    } };
+
+    const bench::registrar stream_write { "mapped_log/write_1M/ofstream", [](bench::state& s) {
+        const std::string path = bench_path("kt_mapped_log_bench.stream");
+        s.max_repetitions(max_reps);
+        s.run([&] { write_stream(path); });
+        s.set_bytes_per_iteration(static_cast<double>(file_bytes(path)));
+        std::remove(path.c_str());
+    } };
+
+    const bench::registrar log_read { "mapped_log/read_1M/mapped_log", [](bench::state& s) {
+        const std::string path = bench_path("kt_mapped_log_bench.log");
+        write_log(path);
+        s.set_bytes_per_iteration(static_cast<double>(file_bytes(path)));
+        s.max_repetitions(max_reps * 2);
+        s.run([&] {
+            const log_t log(path, kt::log_mode::read);
+            checksum sum;
+            log.for_each(sum);
+            bench::do_not_optimize(sum.total);
+        });
+        std::remove(path.c_str());
+    } };
+
+    const bench::registrar stream_read { "mapped_log/read_1M/ifstream", [](bench::state& s) {
+        const std::string path = bench_path("kt_mapped_log_bench.stream");
+        write_stream(path);
+        s.set_bytes_per_iteration(static_cast<double>(file_bytes(path)));
+        s.max_repetitions(max_reps * 2);
+        s.run([&] { bench::do_not_optimize(read_stream(path)); });
+        std::remove(path.c_str());
+    } };
+}
@@ -0,0 +1,84 @@
+/*
+MIT License
+
+Copyright (c) 2023 Kieran Hsieh
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+#include "bench.hpp"
+
+#include <kt/monotonic_arena.hpp>
+
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+namespace {
+    struct header {
+        std::uint64_t id;
+        std::uint32_t flags;
+    };
+
+    struct field {
+        double value;
+        std::uint32_t tag;
+    };
+
+    struct blob {
+        unsigned char bytes[96];
+    };
+
+    using scratch_types = kt::type_list_t<header, field, blob>;
+
+    // One request's worth of scratch objects
+    constexpr size_t objects_per_request = 48;
+
+    const bench::registrar arena_requests { "monotonic_arena/request_scratch/monotonic_arena", [](bench::state& s) {
+        kt::monotonic_arena<scratch_types> arena(objects_per_request);
+        s.set_iterations(256);
+        s.set_items_per_iteration(objects_per_request);
+        s.run([&] {
+            for(size_t i = 0; i < objects_per_request; i += 3) {
+                bench::do_not_optimize(arena.make<header>(header { i, 1 }));
+                bench::do_not_optimize(arena.make<field>(field { 1.5, 2 }));
+                bench::do_not_optimize(arena.make<blob>());
+            }
+            arena.release();
+        });
+    } };
+
+    const bench::registrar unique_requests { "monotonic_arena/request_scratch/make_unique", [](bench::state& s) {
+        std::vector<std::unique_ptr<header>> headers;
+        std::vector<std::unique_ptr<field>> fields;
+        std::vector<std::unique_ptr<blob>> blobs;
+        s.set_iterations(256);
+        s.set_items_per_iteration(objects_per_request);
+        s.run([&] {
+            for(size_t i = 0; i < objects_per_request; i += 3) {
+                headers.push_back(std::make_unique<header>(header { i, 1 }));
+                fields.push_back(std::make_unique<field>(field { 1.5, 2 }));
+                blobs.push_back(std::make_unique<blob>());
+                bench::do_not_optimize(blobs.back().get());
+            }
+            headers.clear();
+            fields.clear();
+            blobs.clear();
+        });
+    } };
+}
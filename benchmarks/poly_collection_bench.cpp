@@ -0,0 +1,136 @@
+/*
+MIT License
+
+Copyright (c) 2023 Kieran Hsieh
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+#include "bench.hpp"
+
+#include <kt/poly_collection.hpp>
+
+#include <algorithm>
+#include <memory>
+#include <random>
+#include <vector>
+
+namespace {
+    struct shape {
+        virtual ~shape() = default;
+        virtual double area() const = 0;
+    };
+
+    struct circle final : shape {
+        explicit circle(double r) : radius(r) { }
+        double area() const override { return 3.14159265358979 * radius * radius; }
+        double radius;
+    };
+
+    struct square final : shape {
+        explicit square(double s) : side(s) { }
+        double area() const override { return side * side; }
+        double side;
+    };
+
+    struct rectangle final : shape {
+        rectangle(double w, double h) : width(w), height(h) { }
+        double area() const override { return width * height; }
+        double width;
+        double height;
+    };
+
+    using shapes = kt::type_list_t<circle, square, rectangle>;
+
+    constexpr size_t element_count = 10'000'000;
+    constexpr size_t max_reps      = 5;
+
+    const std::vector<unsigned char>& kinds() {
+        static const std::vector<unsigned char> out = [] {
+            std::vector<unsigned char> k(element_count);
+            std::mt19937 rng(42);
+            std::uniform_int_distribution<int> dist(0, 2);
+            std::generate(k.begin(), k.end(), [&] { return static_cast<unsigned char>(dist(rng)); });
+            return k;
+        }();
+        return out;
+    }
+
+    void fill(std::vector<std::unique_ptr<shape>>& ptrs) {
+        const auto& k = kinds();
+        ptrs.clear();
+        ptrs.reserve(k.size());
+        for(size_t i = 0; i < k.size(); ++i) {
+            const double v = static_cast<double>(i % 100);
+            switch(k[i]) {
+            case 0: ptrs.push_back(std::make_unique<circle>(v)); break;
+            case 1: ptrs.push_back(std::make_unique<square>(v)); break;
+            default: ptrs.push_back(std::make_unique<rectangle>(v, v + 1)); break;
+            }
+        }
+    }
+
+    void fill(kt::poly_collection<shapes>& pc) {
+        const auto& k = kinds();
+        pc.clear();
+        for(size_t i = 0; i < k.size(); ++i) {
+            const double v = static_cast<double>(i % 100);
+            switch(k[i]) {
+            case 0: pc.emplace(kt::tag<circle>, v); break;
+            case 1: pc.emplace(kt::tag<square>, v); break;
+            default: pc.emplace(kt::tag<rectangle>, v, v + 1); break;
+            }
+        }
+    }
+
+    const bench::registrar pointer_fill { "poly_collection/fill_10M/unique_ptr_vector", [](bench::state& s) {
+        std::vector<std::unique_ptr<shape>> ptrs;
+        s.max_repetitions(max_reps);
+        s.run([&] { fill(ptrs); });
+    } };
+
+    const bench::registrar poly_fill { "poly_collection/fill_10M/poly_collection", [](bench::state& s) {
+        kt::poly_collection<shapes> pc;
+        s.max_repetitions(max_reps);
+        s.run([&] { fill(pc); });
+    } };
+
+    const bench::registrar pointer_iterate { "poly_collection/iterate_10M/unique_ptr_vector", [](bench::state& s) {
+        std::vector<std::unique_ptr<shape>> ptrs;
+        fill(ptrs);
+        s.max_repetitions(max_reps * 4);
+        s.run([&] {
+            double total = 0;
+            for(const auto& p : ptrs) {
+                total += p->area();
+            }
+            bench::do_not_optimize(total);
+        });
+    } };
+
+    const bench::registrar poly_iterate { "poly_collection/iterate_10M/poly_collection", [](bench::state& s) {
+        kt::poly_collection<shapes> pc;
+        fill(pc);
+        s.max_repetitions(max_reps * 4);
+        s.run([&] {
+            double total = 0;
+            pc.for_each([&total](const auto& sh) { total += sh.area(); });
+            bench::do_not_optimize(total);
+        });
+    } };
+}
@@ -0,0 +1,214 @@
+/*
+MIT License
+
+Copyright (c) 2023 Kieran Hsieh
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+#include "bench.hpp"
+
+#include <kt/type_list.hpp>
+#include <kt/visit.hpp>
+
+#include <array>
+#include <cstring>
+#include <random>
+#include <type_traits>
+#include <vector>
+
+namespace {
+    template<size_t I>
+    struct op {
+        static int apply(int x) { return x * static_cast<int>(I + 3) + static_cast<int>(I); }
+    };
+
+    constexpr auto ops = kt::type_list<op<0>, op<1>, op<2>, op<3>, op<4>, op<5>, op<6>, op<7>>;
+
+    using op_fn = int (*)(int);
+
+    template<typename T>
+    int invoke(int x) {
+        return T::apply(x);
+    }
+
+    template<typename... TS>
+    constexpr std::array<op_fn, sizeof...(TS)> make_table(kt::type_list_t<TS...> /* types */) {
+        return { { &invoke<TS>... } };
+    }
+
+    constexpr auto generated_table = make_table(ops);
+
+    constexpr std::array<op_fn, 8> hand_table = { {
+        &op<0>::apply,
+        &op<1>::apply,
+        &op<2>::apply,
+        &op<3>::apply,
+        &op<4>::apply,
+        &op<5>::apply,
+        &op<6>::apply,
+        &op<7>::apply,
+    } };
+
+    int hand_switch(size_t i, int x) {
+        switch(i) {
+        case 0: return op<0>::apply(x);
+        case 1: return op<1>::apply(x);
+        case 2: return op<2>::apply(x);
+        case 3: return op<3>::apply(x);
+        case 4: return op<4>::apply(x);
+        case 5: return op<5>::apply(x);
+        case 6: return op<6>::apply(x);
+        default: return op<7>::apply(x);
+        }
+    }
+
+    const std::vector<unsigned char>& positions() {
+        static const std::vector<unsigned char> pos = [] {
+            std::vector<unsigned char> out(4096);
+            std::mt19937 rng(7);
+            std::uniform_int_distribution<int> dist(0, static_cast<int>(ops.size()) - 1);
+            for(auto& p : out) {
+                p = static_cast<unsigned char>(dist(rng));
+            }
+            return out;
+        }();
+        return pos;
+    }
+
+    template<typename F>
+    void dispatch_case(bench::state& s, F&& dispatch) {
+        const auto& pos = positions();
+        s.set_iterations(64);
+        s.run([&] {
+            int acc = 1;
+            for(const unsigned char p : pos) {
+                acc = dispatch(p, acc);
+            }
+            bench::do_not_optimize(acc);
+        });
+        s.counter("dispatches", static_cast<double>(pos.size()));
+    }
+
+    const bench::registrar dispatch_generated { "dispatch/position/generated_table", [](bench::state& s) {
+        dispatch_case(s, [](size_t i, int x) { return generated_table[i](x); });
+    } };
+
+    const bench::registrar dispatch_visit_at { "dispatch/position/visit_at", [](bench::state& s) {
+        dispatch_case(s, [](size_t i, int x) {
+            return kt::visit_at(ops, i, [x](auto t) { return kt::from_tag_t<decltype(t)>::apply(x); });
+        });
+    } };
+
+    const bench::registrar dispatch_hand_table { "dispatch/position/hand_table", [](bench::state& s) {
+        dispatch_case(s, [](size_t i, int x) { return hand_table[i](x); });
+    } };
+
+    const bench::registrar dispatch_hand_switch { "dispatch/position/hand_switch", [](bench::state& s) {
+        dispatch_case(s, [](size_t i, int x) { return hand_switch(i, x); });
+    } };
+
+    struct record {
+        int id;
+        float price;
+        short qty;
+    };
+
+    constexpr auto records = kt::type_list<int, float, short, record>;
+
+    template<typename T>
+    void copy_all(const T* src, T* dst, size_t n) {
+        if constexpr(records.all_of(kt::func<std::is_trivially_copyable>)) {
+            std::memcpy(dst, src, n * sizeof(T));
+        }
+        else {
+            for(size_t i = 0; i < n; ++i) {
+                dst[i] = src[i];
+            }
+        }
+    }
+
+    template<typename T>
+    auto sum_all(const T* src, size_t n) {
+        using acc_t = std::conditional_t<records.one_of(kt::func<std::is_floating_point>), double, long long>;
+        acc_t acc   = 0;
+        for(size_t i = 0; i < n; ++i) {
+            acc += static_cast<acc_t>(src[i].price);
+        }
+        return acc;
+    }
+
+    template<typename F>
+    void record_case(bench::state& s, F&& body) {
+        static std::vector<record> src(4096, record { 1, 2.5F, 3 });
+        static std::vector<record> dst(4096);
+        s.set_iterations(16);
+        s.set_bytes_per_iteration(static_cast<double>(src.size() * sizeof(record)));
+        s.run([&] { body(src.data(), dst.data(), src.size()); });
+    }
+
+    const bench::registrar all_of_branch { "query/all_of_branch/type_list", [](bench::state& s) {
+        record_case(s, [](const record* src, record* dst, size_t n) {
+            copy_all(src, dst, n);
+            bench::do_not_optimize(dst[0]);
+        });
+    } };
+
+    const bench::registrar all_of_hand { "query/all_of_branch/hand_written", [](bench::state& s) {
+        record_case(s, [](const record* src, record* dst, size_t n) {
+            std::memcpy(dst, src, n * sizeof(record));
+            bench::do_not_optimize(dst[0]);
+        });
+    } };
+
+    const bench::registrar one_of_branch { "query/one_of_branch/type_list", [](bench::state& s) {
+        record_case(s, [](const record* src, record* /* dst */, size_t n) { bench::do_not_optimize(sum_all(src, n)); });
+    } };
+
+    const bench::registrar one_of_hand { "query/one_of_branch/hand_written", [](bench::state& s) {
+        record_case(s, [](const record* src, record* /* dst */, size_t n) {
+            double acc = 0;
+            for(size_t i = 0; i < n; ++i) {
+                acc += static_cast<double>(src[i].price);
+            }
+            bench::do_not_optimize(acc);
+        });
+    } };
+
+    template<typename F>
+    void counter_case(bench::state& s, F&& body) {
+        s.set_iterations(64);
+        s.run([&] {
+            std::array<unsigned, records.size()> counts { };
+            for(const unsigned char p : positions()) {
+                body(counts, p);
+            }
+            bench::do_not_optimize(counts);
+        });
+    }
+
+    const bench::registrar index_of_counter { "query/index_of/type_list", [](bench::state& s) {
+        counter_case(s, [](auto& counts, unsigned char p) {
+            counts[records.index_of(kt::tag<short>)] += p;
+        });
+    } };
+
+    const bench::registrar literal_counter { "query/index_of/hand_written", [](bench::state& s) {
+        counter_case(s, [](auto& counts, unsigned char p) { counts[2] += p; });
+    } };
+}
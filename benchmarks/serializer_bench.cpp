@@ -0,0 +1,190 @@
+/*
+MIT License
+
+Copyright (c) 2023 Kieran Hsieh
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+#include "bench.hpp"
+
+#include <kt/serializer.hpp>
+
+#include <cstdint>
+#include <cstring>
+#include <tuple>
+#include <vector>
+
+namespace {
+    using quote_fields = kt::type_list_t<std::uint64_t, std::uint32_t, std::uint16_t, std::uint8_t, double, double>;
+    using quote_codec  = kt::serializer<quote_fields>;
+    using quote        = quote_codec::record_type;
+    using quote_tuple  = std::tuple<std::uint64_t, std::uint32_t, std::uint16_t, std::uint8_t, double, double>;
+
+    // Fields in this order need no padding, so a field_record's bytes are its wire layout and batches are copied whole
+    using order_fields =
+        kt::type_list_t<std::uint64_t, std::uint64_t, std::uint32_t, std::uint16_t, std::uint8_t, std::uint8_t, double>;
+    using order_codec = kt::serializer<order_fields>;
+    using order       = order_codec::record_type;
+    using order_tuple = std::tuple<std::uint64_t, std::uint64_t, std::uint32_t, std::uint16_t, std::uint8_t, std::uint8_t, double>;
+
+    using row_fields = kt::type_list_t<std::uint64_t, std::uint64_t, std::uint64_t, std::uint64_t, std::uint64_t, std::uint64_t>;
+    using row_codec  = kt::serializer<row_fields>;
+    using row        = std::array<std::uint64_t, 6>;
+
+    constexpr size_t batch_size = 1 << 16;
+
+    // Small enough to stay in cache, so the cases using it measure the copies rather than memory bandwidth
+    constexpr size_t cached_batch_size = 1 << 10;
+
+    // The field-by-field memcpy loop the serializer replaces
+    template<typename R, size_t... IS>
+    void manual_encode(const R& record, unsigned char* out, std::index_sequence<IS...> /* indices */) {
+        using std::get;
+        size_t offset = 0;
+        ((std::memcpy(out + offset, &get<IS>(record), sizeof(get<IS>(record))), offset += sizeof(get<IS>(record))), ...);
+    }
+
+    template<typename R, size_t... IS>
+    void manual_decode(const unsigned char* in, R& record, std::index_sequence<IS...> /* indices */) {
+        using std::get;
+        size_t offset = 0;
+        ((std::memcpy(&get<IS>(record), in + offset, sizeof(get<IS>(record))), offset += sizeof(get<IS>(record))), ...);
+    }
+
+    template<typename R>
+    std::vector<R> make_records(size_t count = batch_size) {
+        using std::get;
+        std::vector<R> records(count);
+        for(size_t i = 0; i < records.size(); ++i) {
+            get<0>(records[i]) = i;
+        }
+        return records;
+    }
+
+    template<typename CODEC, typename R>
+    void encode_case(bench::state& s, bool manual, size_t count = batch_size) {
+        const auto records = make_records<R>(count);
+        std::vector<unsigned char> bytes(records.size() * CODEC::wire_size);
+        s.set_bytes_per_iteration(static_cast<double>(bytes.size()));
+        s.run([&] {
+            if(manual) {
+                for(size_t i = 0; i < records.size(); ++i) {
+                    manual_encode(records[i], bytes.data() + i * CODEC::wire_size, std::make_index_sequence<std::tuple_size<R>::value>());
+                }
+            }
+            else {
+                CODEC::encode_batch(records.data(), records.size(), bytes.data());
+            }
+            bench::do_not_optimize(bytes.front());
+        });
+    }
+
+    template<typename CODEC, typename R>
+    void decode_case(bench::state& s, bool manual, size_t count = batch_size) {
+        auto records = make_records<R>(count);
+        std::vector<unsigned char> bytes(records.size() * CODEC::wire_size);
+        CODEC::encode_batch(records.data(), records.size(), bytes.data());
+        s.set_bytes_per_iteration(static_cast<double>(bytes.size()));
+        s.run([&] {
+            if(manual) {
+                for(size_t i = 0; i < records.size(); ++i) {
+                    manual_decode(bytes.data() + i * CODEC::wire_size, records[i], std::make_index_sequence<std::tuple_size<R>::value>());
+                }
+            }
+            else {
+                CODEC::decode_batch(bytes.data(), records.size(), records.data());
+            }
+            bench::do_not_optimize(records.front());
+        });
+    }
+
+    // field_record is the serializer's default record type, whose fields the serializer copies in runs
+    const bench::registrar encode_quote { "serializer/encode_batch/record/serializer", [](bench::state& s) {
+        encode_case<quote_codec, quote>(s, false);
+    } };
+    const bench::registrar encode_quote_manual { "serializer/encode_batch/record/manual_memcpy", [](bench::state& s) {
+        encode_case<quote_codec, quote>(s, true);
+    } };
+    const bench::registrar decode_quote { "serializer/decode_batch/record/serializer", [](bench::state& s) {
+        decode_case<quote_codec, quote>(s, false);
+    } };
+    const bench::registrar decode_quote_manual { "serializer/decode_batch/record/manual_memcpy", [](bench::state& s) {
+        decode_case<quote_codec, quote>(s, true);
+    } };
+
+    const bench::registrar encode_tuple { "serializer/encode_batch/tuple/serializer", [](bench::state& s) {
+        encode_case<quote_codec, quote_tuple>(s, false);
+    } };
+    const bench::registrar encode_tuple_manual { "serializer/encode_batch/tuple/manual_memcpy", [](bench::state& s) {
+        encode_case<quote_codec, quote_tuple>(s, true);
+    } };
+    const bench::registrar decode_tuple { "serializer/decode_batch/tuple/serializer", [](bench::state& s) {
+        decode_case<quote_codec, quote_tuple>(s, false);
+    } };
+    const bench::registrar decode_tuple_manual { "serializer/decode_batch/tuple/manual_memcpy", [](bench::state& s) {
+        decode_case<quote_codec, quote_tuple>(s, true);
+    } };
+
+    const bench::registrar encode_order { "serializer/encode_batch/unpadded_record/serializer", [](bench::state& s) {
+        encode_case<order_codec, order>(s, false, cached_batch_size);
+    } };
+    const bench::registrar encode_order_manual { "serializer/encode_batch/unpadded_record/manual_memcpy", [](bench::state& s) {
+        encode_case<order_codec, order>(s, true, cached_batch_size);
+    } };
+    const bench::registrar encode_order_tuple { "serializer/encode_batch/unpadded_tuple/manual_memcpy", [](bench::state& s) {
+        encode_case<order_codec, order_tuple>(s, true, cached_batch_size);
+    } };
+    const bench::registrar decode_order { "serializer/decode_batch/unpadded_record/serializer", [](bench::state& s) {
+        decode_case<order_codec, order>(s, false, cached_batch_size);
+    } };
+    const bench::registrar decode_order_manual { "serializer/decode_batch/unpadded_record/manual_memcpy", [](bench::state& s) {
+        decode_case<order_codec, order>(s, true, cached_batch_size);
+    } };
+    const bench::registrar decode_order_tuple { "serializer/decode_batch/unpadded_tuple/manual_memcpy", [](bench::state& s) {
+        decode_case<order_codec, order_tuple>(s, true, cached_batch_size);
+    } };
+
+    const bench::registrar encode_row { "serializer/encode_batch/array/serializer", [](bench::state& s) {
+        encode_case<row_codec, row>(s, false);
+    } };
+    const bench::registrar encode_row_manual { "serializer/encode_batch/array/manual_memcpy", [](bench::state& s) {
+        encode_case<row_codec, row>(s, true);
+    } };
+    const bench::registrar decode_row { "serializer/decode_batch/array/serializer", [](bench::state& s) {
+        decode_case<row_codec, row>(s, false);
+    } };
+    const bench::registrar decode_row_manual { "serializer/decode_batch/array/manual_memcpy", [](bench::state& s) {
+        decode_case<row_codec, row>(s, true);
+    } };
+
+    const bench::registrar view_read { "serializer/view_read/tuple", [](bench::state& s) {
+        const auto records = make_records<quote>();
+        std::vector<unsigned char> bytes(records.size() * quote_codec::wire_size);
+        quote_codec::encode_batch(records.data(), records.size(), bytes.data());
+        s.set_bytes_per_iteration(static_cast<double>(bytes.size()));
+        s.run([&] {
+            std::uint64_t total = 0;
+            kt::view<quote_fields> v(bytes.data());
+            for(size_t i = 0; i < records.size(); ++i, v = v.next()) {
+                total += v.get(kt::index<0>) + v.get(kt::index<3>);
+            }
+            bench::do_not_optimize(total);
+        });
+    } };
+}
@@ -0,0 +1,253 @@
+/*
+MIT License
+
+Copyright (c) 2023 Kieran Hsieh
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+#ifndef KT_CHANNEL_HPP
+#define KT_CHANNEL_HPP
+
+#include <kt/type_list.hpp>
+#include <kt/visit.hpp>
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <new>
+#include <thread>
+#include <type_traits>
+#include <utility>
+
+namespace kt {
+    /**
+     * @brief A bounded, lock-free, multi-producer single-consumer queue of messages whose types are listed in a type list
+     *
+     * @details Messages are stored inline in fixed size slots sized for the largest type in the list, next to a compact index
+     * of their type, so no message is boxed or individually allocated. Any number of threads may push concurrently, but only
+     * one thread at a time may drain. Draining dispatches each message to a callable through a jump table generated from the
+     * type list.
+     *
+     * @tparam TL The type_list_t describing the message types. Every type in the list must be unique.
+     */
+    template<typename TL>
+    class channel;
+
+    /**
+     * @brief Specialization of channel for a type_list_t
+     *
+     * @tparam TS The message types
+     */
+    template<typename... TS>
+    class channel<type_list_t<TS...>> {
+        static_assert(sizeof...(TS) > 0, "Cannot create channel from an empty type list");
+        static_assert(((type_list<TS...>.count_of(tag<TS>) == 1) && ... && true), "Cannot create channel from non-unique types");
+        static_assert(type_list<TS...>.all_of(func<std::is_nothrow_destructible>),
+                      "Cannot create channel from types with throwing destructors");
+
+        static constexpr size_t cache_line = 64;
+
+    public:
+        /**
+         * @brief The type list describing the message types
+         */
+        using types = type_list_t<TS...>;
+
+        /**
+         * @brief The type used to store the index of a message's type in each slot
+         */
+        using index_type = std::conditional_t<(sizeof...(TS) <= 0xFF), std::uint8_t, std::uint16_t>;
+
+        /**
+         * @brief The number of bytes reserved for a message in each slot, the largest size of any message type
+         */
+        static constexpr size_t message_size = type_list<TS...>.layout().max_size;
+
+        /**
+         * @brief The alignment of message storage in each slot, the largest alignment of any message type
+         */
+        static constexpr size_t message_align = type_list<TS...>.layout().max_align;
+
+        /**
+         * @brief Constructs an empty channel
+         *
+         * @param capacity The minimum number of messages the channel can hold. It is rounded up to a power of two.
+         */
+        explicit channel(size_t capacity) : mask_(round_up_pow2(capacity) - 1), slots_(new slot[mask_ + 1]) {
+            for(size_t i = 0; i <= mask_; ++i) {
+                slots_[i].sequence.store(i, std::memory_order_relaxed);
+            }
+        }
+
+        channel(const channel&)            = delete;
+        channel& operator=(const channel&) = delete;
+
+        /**
+         * @brief Destroys any messages which were never drained
+         */
+        ~channel() {
+            drain([](const auto& /* msg */) { });
+        }
+
+        /**
+         * @brief Returns the maximum number of messages the channel can hold
+         */
+        size_t capacity() const { return mask_ + 1; }
+
+        /**
+         * @brief Attempts to push a message without blocking
+         *
+         * @return true if the message was pushed, false if the channel was full
+         *
+         * @note Calling this function will give a compile error if the message type is not in the type list
+         */
+        template<typename T>
+        bool try_push(T&& msg) {
+            return try_emplace(tag<remove_cvref_t<T>>, std::forward<T>(msg));
+        }
+
+        /**
+         * @brief Attempts to construct a message of type T in place without blocking
+         *
+         * @return true if the message was pushed, false if the channel was full
+         *
+         * @note Calling this function will give a compile error if T is not in the type list
+         */
+        template<typename T, typename... ARGS>
+        bool try_emplace(tag_t<T> /* type */, ARGS&&... args) {
+            static_assert(type_list<TS...>.contains(tag<T>), "Type is not a message type of the channel");
+            size_t pos = enqueue_pos_.load(std::memory_order_relaxed);
+            slot* s    = nullptr;
+            for(;;) {
+                s                = &slots_[pos & mask_];
+                const size_t seq = s->sequence.load(std::memory_order_acquire);
+                const auto diff  = static_cast<std::ptrdiff_t>(seq - pos);
+                if(diff == 0) {
+                    if(enqueue_pos_.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+                        break;
+                    }
+                }
+                else if(diff < 0) {
+                    return false;
+                }
+                else {
+                    pos = enqueue_pos_.load(std::memory_order_relaxed);
+                }
+            }
+            // If construction throws, the slot still has to be published so the consumer does not stall. It is marked empty
+            // by storing the out of range index sizeof...(TS).
+            s->type = static_cast<index_type>(sizeof...(TS));
+            try {
+                ::new(static_cast<void*>(s->storage)) T(std::forward<ARGS>(args)...);
+                s->type = static_cast<index_type>(type_list<TS...>.index_of(tag<T>));
+            }
+            catch(...) {
+                s->sequence.store(pos + 1, std::memory_order_release);
+                throw;
+            }
+            s->sequence.store(pos + 1, std::memory_order_release);
+            return true;
+        }
+
+        /**
+         * @brief Pushes a message, yielding the calling thread while the channel is full
+         *
+         * @note Calling this function will give a compile error if the message type is not in the type list
+         */
+        template<typename T>
+        void push(T&& msg) {
+            // try_push only consumes msg when it succeeds, so retrying with the same reference is safe
+            while(!try_push(std::forward<T>(msg))) {
+                std::this_thread::yield();
+            }
+        }
+
+        /**
+         * @brief Consumes up to max_count messages in push order, calling f with each one
+         *
+         * @details f must be callable with an lvalue reference to every message type, and may move from it. Each message is
+         * destroyed after f returns, or if f throws. Slots left empty by a push whose constructor threw are skipped, and do not
+         * count towards max_count. Only one thread may drain at a time.
+         *
+         * @param f The callable, invoked as ```f(T&)```
+         * @param max_count The maximum number of messages to consume in this call
+         *
+         * @return The number of messages passed to f
+         */
+        template<typename F>
+        size_t drain(F&& f, size_t max_count = npos) {
+            size_t count = 0;
+            while(count < max_count) {
+                slot& s = slots_[dequeue_pos_ & mask_];
+                if(s.sequence.load(std::memory_order_acquire) != dequeue_pos_ + 1) {
+                    break;
+                }
+                const release_guard guard { this, s };
+                if(s.type < sizeof...(TS)) {
+                    ++count;
+                    visit_at(types(), s.type, [&s, &f](auto t) {
+                        using T = from_tag_t<decltype(t)>;
+                        f(*std::launder(reinterpret_cast<T*>(s.storage)));
+                    });
+                }
+            }
+            return count;
+        }
+
+    private:
+        struct slot {
+            std::atomic<size_t> sequence;
+            index_type type;
+            alignas(message_align) unsigned char storage[message_size];
+        };
+
+        // Destroys the message in the slot at the front of the queue and hands the slot back to the producers
+        struct release_guard {
+            channel* owner;
+            slot& s;
+
+            ~release_guard() {
+                if(s.type < sizeof...(TS)) {
+                    visit_at(types(), s.type, [this](auto t) {
+                        using T = from_tag_t<decltype(t)>;
+                        std::launder(reinterpret_cast<T*>(s.storage))->~T();
+                    });
+                }
+                s.sequence.store(owner->dequeue_pos_ + owner->mask_ + 1, std::memory_order_release);
+                ++owner->dequeue_pos_;
+            }
+        };
+
+        static size_t round_up_pow2(size_t n) {
+            size_t out = 2;
+            while(out < n) {
+                out <<= 1;
+            }
+            return out;
+        }
+
+        const size_t mask_;
+        const std::unique_ptr<slot[]> slots_;
+        alignas(cache_line) std::atomic<size_t> enqueue_pos_ { 0 };
+        alignas(cache_line) size_t dequeue_pos_ = 0;
+    };
+}
+
+#endif
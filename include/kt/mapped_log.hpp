@@ -0,0 +1,577 @@
+/*
+MIT License
+
+Copyright (c) 2023 Kieran Hsieh
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+#ifndef KT_MAPPED_LOG_HPP
+#define KT_MAPPED_LOG_HPP
+
+#include <kt/type_list.hpp>
+#include <kt/visit.hpp>
+
+#if !defined(__unix__) && !defined(__APPLE__)
+#    error "kt::mapped_log requires a POSIX system"
+#endif
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cerrno>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <iterator>
+#include <new>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <system_error>
+#include <type_traits>
+#include <utility>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace kt {
+    /**
+     * @brief How a mapped_log opens its file
+     */
+    enum class log_mode {
+        read,     /**< Open an existing log for reading only */
+        append,   /**< Open a log for reading and appending, creating it if it does not exist */
+        truncate, /**< Create a new, empty log, replacing any existing file */
+    };
+
+    /**
+     * @cond TURN_OFF_DOXYGEN
+     */
+    namespace detail {
+        // Extracts the spelling of T from the function signature, so the rest of the signature does not affect the fingerprint
+        template<typename T>
+        constexpr std::string_view mapped_log_type_name() {
+#if defined(__clang__) || defined(__GNUC__)
+            // "... [with T = ns::type; std::string_view = ...]" on GCC, "... [T = ns::type]" on Clang
+            constexpr std::string_view signature = __PRETTY_FUNCTION__;
+            constexpr std::string_view key       = "T = ";
+            constexpr size_t start               = signature.find(key) + key.size();
+            constexpr size_t end                 = signature.find(';', start);
+            return signature.substr(start, (end == std::string_view::npos ? signature.size() - 1 : end) - start);
+#elif defined(_MSC_VER)
+            // "... mapped_log_type_name<struct ns::type>(void)"
+            constexpr std::string_view signature = __FUNCSIG__;
+            constexpr std::string_view key       = "mapped_log_type_name<";
+            constexpr size_t start               = signature.find(key) + key.size();
+            return signature.substr(start, signature.rfind(">(void)") - start);
+#else
+            return { };
+#endif
+        }
+
+        constexpr std::uint64_t mapped_log_hash(std::uint64_t hash, std::string_view bytes) {
+            for(const char c : bytes) {
+                hash ^= static_cast<unsigned char>(c);
+                hash *= 1099511628211ULL;
+            }
+            return hash;
+        }
+
+        constexpr std::uint64_t mapped_log_hash(std::uint64_t hash, std::uint64_t value) {
+            for(int i = 0; i < 8; ++i) {
+                hash ^= (value >> (i * 8)) & 0xFF;
+                hash *= 1099511628211ULL;
+            }
+            return hash;
+        }
+
+        template<typename T>
+        constexpr std::uint64_t mapped_log_type_hash(std::uint64_t hash) {
+            hash = mapped_log_hash(mapped_log_hash(hash, sizeof(T)), alignof(T));
+            if constexpr(std::is_arithmetic_v<T>) {
+                // Compilers spell these differently ("long unsigned int" and "unsigned long"), so they are described by kind instead
+                constexpr std::string_view kind = std::is_same_v<T, bool>      ? "bool" :
+                                                  std::is_floating_point_v<T> ? "float" :
+                                                  std::is_signed_v<T>         ? "int" :
+                                                                                "uint";
+                return mapped_log_hash(hash, kind);
+            }
+            else {
+                return mapped_log_hash(hash, mapped_log_type_name<T>());
+            }
+        }
+
+        // FNV-1a over the position, size, alignment, and name of every type in the list.
+        //
+        // The fingerprint changes, and existing logs are rejected, when any of the following change:
+        // - the number or order of the types
+        // - the size or alignment of a type
+        // - the name or enclosing namespace of a non-arithmetic type, including its template arguments
+        // - the compiler's spelling of a non-arithmetic type. GCC and Clang agree for named types, but not for types in anonymous
+        //   namespaces or standard library types with inline namespaces, and MSVC prefixes "struct " or "class ".
+        //
+        // Changing the members of a type without changing its size or alignment is not detected.
+        template<typename... TS>
+        constexpr std::uint64_t mapped_log_fingerprint() {
+            std::uint64_t hash = mapped_log_hash(14695981039346656037ULL, static_cast<std::uint64_t>(sizeof...(TS)));
+            ((hash = mapped_log_type_hash<TS>(hash)), ...);
+            return hash;
+        }
+
+        constexpr size_t mapped_log_round_up(size_t n, size_t align) {
+            return (n + align - 1) / align * align;
+        }
+
+        struct mapped_log_file_header {
+            std::uint64_t magic;
+            std::uint64_t fingerprint;
+            std::uint64_t data_end;
+            std::uint64_t record_align;
+        };
+
+        struct mapped_log_record_header {
+            std::uint32_t type;
+            std::uint32_t size;
+        };
+    }
+    /**
+     * @endcond
+     */
+
+    /**
+     * @brief An append-only log of records whose types are listed in a type list, stored in a memory-mapped file
+     *
+     * @details Each record is stored as a small header holding its type index and length, followed by the object's bytes, aligned
+     * so it can be read in place. The file grows in large chunks. Reading walks the mapping directly and hands each record to a
+     * callable as ```const T&``` without copying.
+     *
+     * The file header embeds a fingerprint of the type list, which covers each type's position, size, alignment, and name.
+     * Opening a file written with a different list throws std::runtime_error. Records are stored in the host's representation,
+     * so a log can only be read on machines with the same byte order. A log should be written by only one mapped_log at a time.
+     *
+     * A log opened with log_mode::read sees the records that existed when it was opened. While another mapped_log appends to the
+     * same file, refresh picks up the records appended since.
+     *
+     * @tparam TL The type_list_t describing the record types. Every type must be trivially copyable.
+     */
+    template<typename TL>
+    class mapped_log;
+
+    /**
+     * @brief Specialization of mapped_log for a type_list_t
+     *
+     * @tparam TS The record types
+     */
+    template<typename... TS>
+    class mapped_log<type_list_t<TS...>> {
+        static_assert(sizeof...(TS) > 0, "Cannot create mapped_log from an empty type list");
+        static_assert(type_list<TS...>.all_of(func<std::is_trivially_copyable>), "Cannot log non-trivially copyable types");
+        static_assert(((sizeof(TS) <= UINT32_MAX) && ... && true), "Cannot log types larger than 4GiB");
+
+        using file_header_t   = detail::mapped_log_file_header;
+        using record_header_t = detail::mapped_log_record_header;
+
+        static constexpr std::uint64_t magic = 0x31474F4C4D544BULL; // "KTMLOG1"
+
+    public:
+        /**
+         * @brief The type list describing the record types
+         */
+        using types = type_list_t<TS...>;
+
+        /**
+         * @brief The fingerprint of the type list stored in the file header
+         */
+        static constexpr std::uint64_t fingerprint = detail::mapped_log_fingerprint<TS...>();
+
+        /**
+         * @brief The alignment of every record header and record in the file
+         */
+        static constexpr size_t record_align = std::max(alignof(record_header_t), type_list<TS...>.layout().max_align);
+
+        /**
+         * @brief The default number of bytes the file grows by when it runs out of space
+         */
+        static constexpr size_t default_chunk_size = size_t(64) << 20;
+
+        /**
+         * @brief A record in the log, referring directly into the mapped file
+         */
+        class record {
+        public:
+            /**
+             * @brief Returns the index of the record's type in the type list
+             */
+            size_t index() const { return header()->type; }
+
+            /**
+             * @brief Returns the size of the record in bytes
+             */
+            size_t size() const { return header()->size; }
+
+            /**
+             * @brief Returns a pointer to the record's bytes
+             */
+            const void* data() const { return pos_ + payload_offset; }
+
+            /**
+             * @brief Calls f with a reference to the record as its stored type
+             *
+             * @details f must be callable with a const reference to every type in the type list, and return the same type for each.
+             *
+             * @throws std::runtime_error if the record's header is corrupt
+             */
+            template<typename F>
+            decltype(auto) visit(F&& f) const {
+                check();
+                return visit_at(types(), index(), [this, &f](auto t) -> decltype(auto) {
+                    using T = from_tag_t<decltype(t)>;
+                    return f(*std::launder(reinterpret_cast<const T*>(data())));
+                });
+            }
+
+        private:
+            friend class mapped_log;
+
+            record(const unsigned char* pos, const unsigned char* end) : pos_(pos), end_(end) { }
+
+            const record_header_t* header() const { return reinterpret_cast<const record_header_t*>(pos_); }
+
+            // The header is read from the file, so it is checked before it is used to dispatch or to find the next record
+            void check() const {
+                const auto available = static_cast<size_t>(end_ - pos_);
+                if(available < payload_offset) {
+                    throw std::runtime_error("mapped_log: corrupt record header");
+                }
+                const size_t type = index();
+                if(type >= sizeof...(TS) || size() != record_sizes[type] || available < stride(size())) {
+                    throw std::runtime_error("mapped_log: corrupt record header");
+                }
+            }
+
+            const unsigned char* pos_;
+            const unsigned char* end_;
+        };
+
+        /**
+         * @brief A forward iterator over the records in the log
+         */
+        class iterator {
+        public:
+            using iterator_category = std::forward_iterator_tag;
+            using value_type        = record;
+            using difference_type   = std::ptrdiff_t;
+            using pointer           = const record*;
+            using reference         = const record&;
+
+            iterator() : rec_(nullptr, nullptr) { }
+
+            reference operator*() const { return rec_; }
+            pointer operator->() const { return &rec_; }
+
+            /**
+             * @throws std::runtime_error if the current record's header is corrupt
+             */
+            iterator& operator++() {
+                rec_.check();
+                rec_.pos_ += stride(rec_.size());
+                return *this;
+            }
+
+            iterator operator++(int) {
+                iterator out = *this;
+                ++*this;
+                return out;
+            }
+
+            bool operator==(const iterator& other) const { return rec_.pos_ == other.rec_.pos_; }
+            bool operator!=(const iterator& other) const { return rec_.pos_ != other.rec_.pos_; }
+
+        private:
+            friend class mapped_log;
+
+            iterator(const unsigned char* pos, const unsigned char* end) : rec_(pos, end) { }
+
+            record rec_;
+        };
+
+        /**
+         * @brief Opens or creates a log
+         *
+         * @param path The path to the file
+         * @param mode How to open the file
+         * @param chunk_size The number of bytes the file grows by when an append runs out of space
+         *
+         * @throws std::system_error if the file cannot be opened or mapped
+         * @throws std::runtime_error if the file is not a log, or was written with a different type list
+         */
+        explicit mapped_log(const std::string& path, log_mode mode = log_mode::append, size_t chunk_size = default_chunk_size) :
+            writable_(mode != log_mode::read), chunk_size_(detail::mapped_log_round_up(std::max<size_t>(chunk_size, 1), page_size())) {
+            int flags = writable_ ? O_RDWR | O_CREAT : O_RDONLY;
+            if(mode == log_mode::truncate) {
+                flags |= O_TRUNC;
+            }
+            fd_ = ::open(path.c_str(), flags, 0644);
+            if(fd_ < 0) {
+                throw std::system_error(errno, std::generic_category(), "mapped_log: cannot open " + path);
+            }
+            try {
+                struct stat st { };
+                if(::fstat(fd_, &st) != 0) {
+                    throw std::system_error(errno, std::generic_category(), "mapped_log: cannot stat " + path);
+                }
+                const auto file_size = static_cast<size_t>(st.st_size);
+                if(file_size == 0 && writable_) {
+                    map(chunk_size_);
+                    const file_header_t header { magic, fingerprint, data_begin, record_align };
+                    std::memcpy(base_, &header, sizeof(header));
+                    end_ = data_begin;
+                }
+                else {
+                    if(file_size < sizeof(file_header_t)) {
+                        throw std::runtime_error("mapped_log: " + path + " is not a mapped_log file");
+                    }
+                    map(file_size);
+                    validate(path);
+                }
+                valid_ = true;
+            }
+            catch(...) {
+                close();
+                throw;
+            }
+        }
+
+        mapped_log(const mapped_log&)            = delete;
+        mapped_log& operator=(const mapped_log&) = delete;
+
+        /**
+         * @brief Unmaps and closes the file, trimming any unused space reserved for appends
+         */
+        ~mapped_log() { close(); }
+
+        /**
+         * @brief Appends a record to the end of the log
+         *
+         * @throws std::logic_error if the log was opened with log_mode::read
+         * @throws std::system_error if the file cannot be grown, in which case the log is left unchanged
+         *
+         * @note Growing the file moves the mapping, so appending invalidates all iterators and records obtained from the log
+         * @note Calling this function will give a compile error if T is not in the type list
+         */
+        template<typename T>
+        void append(const T& value) {
+            static_assert(type_list<TS...>.contains(tag<T>), "Type is not a record type of the mapped_log");
+            if(!writable_) {
+                throw std::logic_error("mapped_log: cannot append to a log opened for reading");
+            }
+            const size_t end  = end_;
+            const size_t next = end + stride(sizeof(T));
+            if(next > capacity_) {
+                grow(next);
+            }
+            constexpr auto type = static_cast<std::uint32_t>(type_list<TS...>.index_of(tag<T>));
+            const record_header_t header { type, static_cast<std::uint32_t>(sizeof(T)) };
+            std::memcpy(base_ + end, &header, sizeof(header));
+            std::memcpy(base_ + end + payload_offset, &value, sizeof(T));
+            set_data_end(next);
+        }
+
+        /**
+         * @brief Calls f with a reference to every record in the log, in append order
+         *
+         * @details f must be callable with a const reference to every type in the type list.
+         *
+         * @throws std::runtime_error if a record's header is corrupt
+         */
+        template<typename F>
+        void for_each(F&& f) const {
+            for(const record& rec : *this) {
+                rec.visit(f);
+            }
+        }
+
+        /**
+         * @brief Returns an iterator to the first record
+         */
+        iterator begin() const { return iterator(base_ + data_begin, base_ + end_); }
+
+        /**
+         * @brief Returns an iterator past the last record
+         */
+        iterator end() const { return iterator(base_ + end_, base_ + end_); }
+
+        /**
+         * @brief Returns if the log holds no records
+         */
+        bool empty() const { return end_ == data_begin; }
+
+        /**
+         * @brief Returns the number of bytes used by records, including their headers
+         */
+        size_t bytes() const { return end_ - data_begin; }
+
+        /**
+         * @brief Returns the number of bytes currently mapped
+         */
+        size_t capacity() const { return capacity_; }
+
+        /**
+         * @brief Writes all appended records to the file, blocking until the write completes
+         *
+         * @throws std::system_error if the mapping cannot be synchronized
+         */
+        void flush() {
+            if(writable_ && ::msync(base_, capacity_, MS_SYNC) != 0) {
+                throw std::system_error(errno, std::generic_category(), "mapped_log: cannot sync");
+            }
+        }
+
+        /**
+         * @brief Makes the records appended to the file since the log was opened or last refreshed visible to this log
+         *
+         * @details Does nothing for a log opened for appending, which always sees its own records.
+         *
+         * @throws std::system_error if the file cannot be mapped
+         * @throws std::runtime_error if the file is shorter than its recorded end
+         *
+         * @note Refreshing may move the mapping, which invalidates all iterators and records obtained from the log
+         */
+        void refresh() {
+            if(writable_) {
+                return;
+            }
+            const size_t end = stored_data_end();
+            std::atomic_thread_fence(std::memory_order_acquire);
+            if(end < data_begin) {
+                throw std::runtime_error("mapped_log: file is truncated");
+            }
+            if(end > capacity_) {
+                // The writer extends the file before it publishes an end past the old size, so the file already covers end
+                struct stat st { };
+                if(::fstat(fd_, &st) != 0) {
+                    throw std::system_error(errno, std::generic_category(), "mapped_log: cannot stat file");
+                }
+                const auto file_size = static_cast<size_t>(st.st_size);
+                if(file_size < end) {
+                    throw std::runtime_error("mapped_log: file is truncated");
+                }
+                remap(file_size);
+            }
+            end_ = end;
+        }
+
+    private:
+        static constexpr size_t data_begin     = detail::mapped_log_round_up(sizeof(file_header_t), record_align);
+        static constexpr size_t payload_offset = detail::mapped_log_round_up(sizeof(record_header_t), record_align);
+
+        static constexpr std::array<size_t, sizeof...(TS)> record_sizes { { sizeof(TS)... } };
+
+        static constexpr size_t stride(size_t size) { return payload_offset + detail::mapped_log_round_up(size, record_align); }
+
+        static size_t page_size() { return static_cast<size_t>(::sysconf(_SC_PAGESIZE)); }
+
+        // The end stored in the file can move while another mapped_log appends, so a reader only trusts the end_ it last checked
+        size_t stored_data_end() const {
+            std::uint64_t end = 0;
+            std::memcpy(&end, base_ + offsetof(file_header_t, data_end), sizeof(end));
+            return static_cast<size_t>(end);
+        }
+
+        void set_data_end(size_t end) {
+            const auto value = static_cast<std::uint64_t>(end);
+            end_             = end;
+            std::atomic_thread_fence(std::memory_order_release);
+            std::memcpy(base_ + offsetof(file_header_t, data_end), &value, sizeof(value));
+        }
+
+        void validate(const std::string& path) {
+            file_header_t header { };
+            std::memcpy(&header, base_, sizeof(header));
+            if(header.magic != magic) {
+                throw std::runtime_error("mapped_log: " + path + " is not a mapped_log file");
+            }
+            if(header.fingerprint != fingerprint || header.record_align != record_align) {
+                throw std::runtime_error("mapped_log: " + path + " was written with a different type list");
+            }
+            if(header.data_end < data_begin || header.data_end > capacity_) {
+                throw std::runtime_error("mapped_log: " + path + " is truncated");
+            }
+            end_ = static_cast<size_t>(header.data_end);
+        }
+
+        unsigned char* map_file(size_t size) const {
+            if(writable_ && ::ftruncate(fd_, static_cast<off_t>(size)) != 0) {
+                throw std::system_error(errno, std::generic_category(), "mapped_log: cannot resize file");
+            }
+            const int prot = writable_ ? PROT_READ | PROT_WRITE : PROT_READ;
+            void* addr     = ::mmap(nullptr, size, prot, MAP_SHARED, fd_, 0);
+            if(addr == MAP_FAILED) {
+                throw std::system_error(errno, std::generic_category(), "mapped_log: cannot map file");
+            }
+            return static_cast<unsigned char*>(addr);
+        }
+
+        void map(size_t size) {
+            base_     = map_file(size);
+            capacity_ = size;
+        }
+
+        void grow(size_t required) {
+            remap(detail::mapped_log_round_up(std::max(required, capacity_ + chunk_size_), chunk_size_));
+        }
+
+        void remap(size_t size) {
+            // The old mapping is only released once the new one exists, so a failure leaves the log usable at its old capacity.
+            // A growing writer may have extended the file already, which close trims away.
+            unsigned char* addr = map_file(size);
+            ::munmap(base_, capacity_);
+            base_     = addr;
+            capacity_ = size;
+        }
+
+        void close() {
+            if(base_ != nullptr) {
+                const size_t end = valid_ ? end_ : 0;
+                ::munmap(base_, capacity_);
+                base_ = nullptr;
+                if(writable_ && valid_) {
+                    // Trim the space reserved for future appends. Failing here only leaves the file larger than it needs to be.
+                    static_cast<void>(::ftruncate(fd_, static_cast<off_t>(end)));
+                }
+            }
+            if(fd_ >= 0) {
+                ::close(fd_);
+                fd_ = -1;
+            }
+        }
+
+        bool writable_;
+        bool valid_ = false;
+        size_t chunk_size_;
+        int fd_              = -1;
+        unsigned char* base_ = nullptr;
+        size_t capacity_     = 0;
+        size_t end_          = 0;
+    };
+}
+
+#endif
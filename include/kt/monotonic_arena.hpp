@@ -0,0 +1,207 @@
+/*
+MIT License
+
+Copyright (c) 2023 Kieran Hsieh
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+#ifndef KT_MONOTONIC_ARENA_HPP
+#define KT_MONOTONIC_ARENA_HPP
+
+#include <kt/type_list.hpp>
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+namespace kt {
+    /**
+     * @brief A bump-pointer allocator for objects whose types are listed in a type list
+     *
+     * @details Memory is handed out from blocks sized from the type list's layout, so allocating an object is a pointer bump
+     * within the current block. Blocks are kept across calls to release and reused, so a steady workload stops allocating from the
+     * system after the first few rounds. Objects are never freed individually. If every type in the list is trivially destructible,
+     * no destructor bookkeeping is kept at all. Otherwise, objects of non-trivially destructible types are destroyed in reverse
+     * order of construction on release.
+     *
+     * @tparam TL The type_list_t describing the object types
+     */
+    template<typename TL>
+    class monotonic_arena;
+
+    /**
+     * @brief Specialization of monotonic_arena for a type_list_t
+     *
+     * @tparam TS The object types
+     */
+    template<typename... TS>
+    class monotonic_arena<type_list_t<TS...>> {
+        static_assert(sizeof...(TS) > 0, "Cannot create monotonic_arena from an empty type list");
+
+        static constexpr auto layout = type_list<TS...>.layout();
+
+        struct destructor_node {
+            destructor_node* next;
+            void (*destroy)(void*);
+            void* object;
+        };
+
+        struct block {
+            block* next;
+            size_t size;
+        };
+
+        static constexpr size_t round_up(size_t n, size_t align) { return (n + align - 1) / align * align; }
+
+        static constexpr size_t block_align = std::max({ layout.max_align, alignof(block), alignof(destructor_node) });
+        static constexpr size_t header_size = round_up(sizeof(block), block_align);
+
+        // Destructor records are interleaved with the objects, so slots are aligned for both to leave room for the padding between them
+        static constexpr size_t slot_align =
+            layout.trivially_destructible ? layout.max_align : std::max(layout.max_align, alignof(destructor_node));
+
+        // The space reserved in a block for each object, large enough for any type in the list and its destructor record
+        static constexpr size_t slot_size =
+            round_up(layout.max_size, slot_align) + (layout.trivially_destructible ? 0 : round_up(sizeof(destructor_node), slot_align));
+
+    public:
+        /**
+         * @brief Constructs an arena and allocates its first block
+         *
+         * @param objects_per_block The number of objects of the largest type in the list which fit in each block
+         */
+        explicit monotonic_arena(size_t objects_per_block = 64) :
+            block_size_(header_size + slot_size * (objects_per_block == 0 ? 1 : objects_per_block)) {
+            head_    = allocate_block();
+            current_ = head_;
+            reset_to(head_);
+        }
+
+        monotonic_arena(const monotonic_arena&)            = delete;
+        monotonic_arena& operator=(const monotonic_arena&) = delete;
+
+        /**
+         * @brief Destroys all objects and frees all blocks
+         */
+        ~monotonic_arena() {
+            release();
+            while(head_ != nullptr) {
+                block* next = head_->next;
+                ::operator delete(static_cast<void*>(head_), std::align_val_t(block_align));
+                head_ = next;
+            }
+        }
+
+        /**
+         * @brief Constructs an object of type T in the arena
+         *
+         * @return A pointer to the new object, valid until release is called or the arena is destroyed
+         *
+         * @note Calling this function will give a compile error if T is not in the type list
+         */
+        template<typename T, typename... ARGS>
+        T* make(ARGS&&... args) {
+            static_assert(type_list<TS...>.contains(tag<T>), "Type is not an object type of the monotonic_arena");
+            if constexpr(layout.trivially_destructible || std::is_trivially_destructible_v<T>) {
+                return ::new(allocate(sizeof(T), alignof(T))) T(std::forward<ARGS>(args)...);
+            }
+            else {
+                // The record is allocated first, so once the object exists registering it cannot fail
+                void* node_mem = allocate(sizeof(destructor_node), alignof(destructor_node));
+                T* obj         = ::new(allocate(sizeof(T), alignof(T))) T(std::forward<ARGS>(args)...);
+                destructors_   = ::new(node_mem) destructor_node { destructors_, &destroy<T>, obj };
+                return obj;
+            }
+        }
+
+        /**
+         * @brief Destroys all objects in the arena and makes all of its blocks available for reuse
+         */
+        void release() {
+            if constexpr(!layout.trivially_destructible) {
+                while(destructors_ != nullptr) {
+                    destructor_node* node = destructors_;
+                    destructors_          = node->next;
+                    node->destroy(node->object);
+                }
+            }
+            current_ = head_;
+            reset_to(head_);
+        }
+
+        /**
+         * @brief Returns the size in bytes of each block, including bookkeeping
+         */
+        size_t block_size() const { return block_size_; }
+
+        /**
+         * @brief Returns the number of blocks the arena has allocated
+         */
+        size_t block_count() const {
+            size_t count = 0;
+            for(const block* b = head_; b != nullptr; b = b->next) {
+                ++count;
+            }
+            return count;
+        }
+
+    private:
+        template<typename T>
+        static void destroy(void* object) {
+            static_cast<T*>(object)->~T();
+        }
+
+        block* allocate_block() {
+            void* mem = ::operator new(block_size_, std::align_val_t(block_align));
+            return ::new(mem) block { nullptr, block_size_ };
+        }
+
+        void reset_to(block* b) {
+            cur_ = reinterpret_cast<std::uintptr_t>(b) + header_size;
+            end_ = reinterpret_cast<std::uintptr_t>(b) + b->size;
+        }
+
+        void* allocate(size_t size, size_t align) {
+            std::uintptr_t pos = round_up(cur_, align);
+            if(pos + size > end_) {
+                // Every object fits in a fresh block, since blocks hold at least one slot of the largest type
+                if(current_->next == nullptr) {
+                    current_->next = allocate_block();
+                }
+                current_ = current_->next;
+                reset_to(current_);
+                pos = round_up(cur_, align);
+            }
+            cur_ = pos + size;
+            return reinterpret_cast<void*>(pos);
+        }
+
+        size_t block_size_;
+        block* head_                  = nullptr;
+        block* current_               = nullptr;
+        std::uintptr_t cur_           = 0;
+        std::uintptr_t end_           = 0;
+        destructor_node* destructors_ = nullptr;
+    };
+}
+
+#endif
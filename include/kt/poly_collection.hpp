@@ -0,0 +1,208 @@
+/*
+MIT License
+
+Copyright (c) 2023 Kieran Hsieh
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+#ifndef KT_POLY_COLLECTION_HPP
+#define KT_POLY_COLLECTION_HPP
+
+#include <kt/type_list.hpp>
+
+#include <cstddef>
+#include <iterator>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace kt {
+    /**
+     * @brief A heterogeneous container which stores each element type of a type list in its own contiguous bucket
+     *
+     * @details Elements are routed to the bucket for their type on insertion, so no element needs its own heap allocation and
+     * iteration visits every element of one type before moving on to the next, with each call resolved at compile time.
+     * Insertion order is only preserved between elements of the same type.
+     *
+     * @tparam TL The type_list_t describing the element types. Every type in the list must be unique, and bool is not allowed since
+     * std::vector<bool> does not hold bool objects that can be referenced.
+     */
+    template<typename TL>
+    class poly_collection;
+
+    /**
+     * @brief Specialization of poly_collection for a type_list_t
+     *
+     * @tparam TS The element types
+     */
+    template<typename... TS>
+    class poly_collection<type_list_t<TS...>> {
+        static_assert(((type_list<TS...>.count_of(tag<TS>) == 1) && ... && true), "Cannot create poly_collection from non-unique types");
+        static_assert(!type_list<TS...>.contains(tag<bool>), "Cannot create poly_collection with bool, wrap it in a struct instead");
+
+    public:
+        /**
+         * @brief The type_list_t describing the element types
+         */
+        using types = type_list_t<TS...>;
+
+        /**
+         * @brief Inserts an element into the bucket for its type
+         *
+         * @tparam T The element type, after removing const, volatile, and reference qualifiers
+         *
+         * @note Calling this function will give a compile error if T is not in the type list
+         */
+        template<typename T>
+        void insert(T&& value) {
+            bucket(tag<remove_cvref_t<T>>).push_back(std::forward<T>(value));
+        }
+
+        /**
+         * @brief Constructs an element of type T in place at the end of its bucket
+         *
+         * @tparam T The element type
+         * @tparam ARGS The constructor argument types
+         *
+         * @return A reference to the constructed element
+         *
+         * @note Calling this function will give a compile error if T is not in the type list
+         */
+        template<typename T, typename... ARGS>
+        T& emplace(tag_t<T> /* type */, ARGS&&... args) {
+            return bucket(tag<T>).emplace_back(std::forward<ARGS>(args)...);
+        }
+
+        /**
+         * @brief Inserts a range of elements of the same type with a single bucket insertion
+         *
+         * @details The element type is the value type of the iterators. Forward iterators let the bucket grow once for the
+         * whole range.
+         *
+         * @note Calling this function will give a compile error if the iterator's value type is not in the type list
+         */
+        template<typename IT>
+        void insert_range(IT first, IT last) {
+            auto& elems = bucket(tag<typename std::iterator_traits<IT>::value_type>);
+            elems.insert(elems.end(), first, last);
+        }
+
+        /**
+         * @brief Reserves space for at least n elements in the bucket for type T
+         *
+         * @tparam T The element type
+         */
+        template<typename T>
+        void reserve(tag_t<T> /* type */, size_t n) {
+            bucket(tag<T>).reserve(n);
+        }
+
+        /**
+         * @brief Returns the bucket holding all elements of type T
+         *
+         * @tparam T The element type
+         */
+        template<typename T>
+        std::vector<T>& bucket(tag_t<T> /* type */) {
+            check_type<T>();
+            return std::get<std::vector<T>>(buckets_);
+        }
+
+        /**
+         * @brief Returns the bucket holding all elements of type T
+         *
+         * @tparam T The element type
+         */
+        template<typename T>
+        const std::vector<T>& bucket(tag_t<T> /* type */) const {
+            check_type<T>();
+            return std::get<std::vector<T>>(buckets_);
+        }
+
+        /**
+         * @brief Calls f on every element, one bucket at a time in type list order
+         *
+         * @details f must be callable with a reference to every type in the type list. Each bucket is walked with its own loop,
+         * so the call to f is resolved statically for every element.
+         */
+        template<typename F>
+        void for_each(F&& f) {
+            std::apply([&f](auto&... elems) { (for_each_in(elems, f), ...); }, buckets_);
+        }
+
+        /**
+         * @brief Calls f on every element, one bucket at a time in type list order
+         *
+         * @details f must be callable with a const reference to every type in the type list.
+         */
+        template<typename F>
+        void for_each(F&& f) const {
+            std::apply([&f](const auto&... elems) { (for_each_in(elems, f), ...); }, buckets_);
+        }
+
+        /**
+         * @brief Returns the total number of elements in the collection
+         */
+        size_t size() const {
+            return std::apply([](const auto&... elems) { return (elems.size() + ... + size_t(0)); }, buckets_);
+        }
+
+        /**
+         * @brief Returns the number of elements of type T in the collection
+         *
+         * @tparam T The element type
+         */
+        template<typename T>
+        size_t size(tag_t<T> /* type */) const {
+            return bucket(tag<T>).size();
+        }
+
+        /**
+         * @brief Returns if the collection contains no elements
+         */
+        bool empty() const {
+            return std::apply([](const auto&... elems) { return (elems.empty() && ... && true); }, buckets_);
+        }
+
+        /**
+         * @brief Removes all elements from the collection, keeping the capacity of every bucket
+         */
+        void clear() {
+            std::apply([](auto&... elems) { (elems.clear(), ...); }, buckets_);
+        }
+
+    private:
+        template<typename T>
+        static constexpr void check_type() {
+            static_assert(type_list<TS...>.contains(tag<T>), "Type is not an element type of the poly_collection");
+        }
+
+        template<typename V, typename F>
+        static void for_each_in(V& elems, F& f) {
+            for(auto& elem : elems) {
+                f(elem);
+            }
+        }
+
+        std::tuple<std::vector<TS>...> buckets_;
+    };
+}
+
+#endif
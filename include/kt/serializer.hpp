@@ -0,0 +1,601 @@
+/*
+MIT License
+
+Copyright (c) 2023 Kieran Hsieh
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+#ifndef KT_SERIALIZER_HPP
+#define KT_SERIALIZER_HPP
+
+#include <kt/type_list.hpp>
+
+#include <array>
+#include <cassert>
+#include <cstddef>
+#include <cstring>
+#include <memory>
+#include <new>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+namespace kt {
+    template<typename... TS>
+    class field_record;
+
+    template<size_t I, typename... TS>
+    auto& get(field_record<TS...>& record);
+
+    template<size_t I, typename... TS>
+    const auto& get(const field_record<TS...>& record);
+
+    /**
+     * @cond TURN_OFF_DOXYGEN
+     */
+    namespace detail {
+#if defined(__BYTE_ORDER__) && defined(__ORDER_BIG_ENDIAN__) && __BYTE_ORDER__ == __ORDER_BIG_ENDIAN__
+        constexpr bool host_is_little_endian = false;
+#else
+        constexpr bool host_is_little_endian = true;
+#endif
+
+        // The wire format is little-endian, so only multi-byte scalars need converting, and only on big-endian hosts
+        template<typename T>
+        constexpr bool serializer_needs_swap = !host_is_little_endian && (std::is_arithmetic_v<T> || std::is_enum_v<T>) && sizeof(T) > 1;
+
+        template<typename T>
+        inline void serializer_store(unsigned char* out, const T& value) {
+            std::memcpy(out, &value, sizeof(T));
+            if constexpr(serializer_needs_swap<T>) {
+                for(size_t i = 0; i < sizeof(T) / 2; ++i) {
+                    std::swap(out[i], out[sizeof(T) - 1 - i]);
+                }
+            }
+        }
+
+        template<typename T>
+        inline void serializer_load_bytes(const unsigned char* in, unsigned char* out) {
+            if constexpr(serializer_needs_swap<T>) {
+                for(size_t i = 0; i < sizeof(T); ++i) {
+                    out[i] = in[sizeof(T) - 1 - i];
+                }
+            }
+            else {
+                std::memcpy(out, in, sizeof(T));
+            }
+        }
+
+        template<typename T>
+        inline void serializer_load(const unsigned char* in, T& value) {
+            serializer_load_bytes<T>(in, reinterpret_cast<unsigned char*>(std::addressof(value)));
+        }
+
+        // Loads into raw storage, so T does not need to be default constructible
+        template<typename T>
+        inline T serializer_read(const unsigned char* in) {
+            alignas(T) unsigned char bytes[sizeof(T)];
+            serializer_load_bytes<T>(in, bytes);
+            return *std::launder(reinterpret_cast<T*>(bytes));
+        }
+
+        constexpr size_t serializer_round_up(size_t n, size_t align) {
+            return (n + align - 1) / align * align;
+        }
+
+        // Fields in type list order, each at its natural alignment, as a struct with one member per field would lay them out
+        template<typename... TS>
+        struct field_record_layout {
+            static constexpr size_t count = sizeof...(TS);
+            static constexpr size_t align = type_list<TS...>.layout().max_align;
+
+            // The offset of each field, followed by the end of the last field
+            static constexpr std::array<size_t, count + 1> bounds = [] {
+                constexpr std::array<size_t, count> sizes { { sizeof(TS)... } };
+                constexpr std::array<size_t, count> aligns { { alignof(TS)... } };
+                std::array<size_t, count + 1> out { };
+                for(size_t i = 0; i < count; ++i) {
+                    out[i]     = serializer_round_up(out[i], aligns[i]);
+                    out[i + 1] = out[i] + sizes[i];
+                }
+                return out;
+            }();
+
+            // An empty record still occupies one byte, like an empty struct
+            static constexpr size_t size = count == 0 ? 1 : serializer_round_up(bounds[count], align);
+        };
+
+        template<typename... TS>
+        struct serializer_layout {
+            static constexpr size_t count = sizeof...(TS);
+
+            static constexpr std::array<size_t, count> sizes { { sizeof(TS)... } };
+            static constexpr std::array<bool, count> swaps { { serializer_needs_swap<TS>... } };
+
+            // Fields are packed back to back in type list order
+            static constexpr std::array<size_t, count> offsets = type_list<TS...>.layout().offsets;
+            static constexpr size_t wire_size                  = type_list<TS...>.layout().packed_size;
+        };
+
+        template<size_t N>
+        struct serializer_runs {
+            std::array<size_t, N> start { };
+            std::array<size_t, N> end { };
+        };
+
+        // A run is a maximal group of adjacent fields which need no conversion and sit back to back in the record, so they can share
+        // one memcpy. Fields of records whose layout is not known each form their own run.
+        template<size_t N>
+        constexpr serializer_runs<N> serializer_make_runs(const std::array<size_t, N>& sizes,
+                                                          const std::array<bool, N>& swaps,
+                                                          const std::array<size_t, N>& offsets,
+                                                          bool known) {
+            serializer_runs<N> out;
+            for(size_t i = 0; i < N; ++i) {
+                const bool joins = known && i > 0 && !swaps[i] && !swaps[i - 1] && offsets[i] == offsets[i - 1] + sizes[i - 1];
+                out.start[i]     = joins ? out.start[i - 1] : i;
+            }
+            for(size_t i = N; i > 0; --i) {
+                out.end[i - 1] = (i == N || out.start[i] == i) ? i : out.end[i];
+            }
+            return out;
+        }
+
+        template<typename R>
+        struct serializer_record_offsets {
+            static constexpr bool known = false;
+        };
+
+        template<typename... TS>
+        struct serializer_record_offsets<field_record<TS...>> {
+            static constexpr bool known = true;
+            static constexpr auto& bounds = field_record_layout<TS...>::bounds;
+        };
+    }
+    /**
+     * @endcond
+     */
+
+    /**
+     * @brief Marks a tuple-like record type whose elements are stored back to back in order with no padding
+     *
+     * @details Specialize this to std::true_type for a record type R when ```get<I>(record)``` is always at byte offset
+     * ```serializer::offset(index<I>)``` from the start of the record. The serializer then copies adjacent fields which need no
+     * conversion with a single memcpy, and copies whole records and batches at once when no field needs converting. This is
+     * enabled for std::array.
+     *
+     * Marking a record whose fields are at other offsets, such as a struct with padding between fields, makes encoding and
+     * decoding it undefined behavior. The serializer rejects marked records smaller than the wire size, and checks the offsets
+     * of the fields with assert.
+     *
+     * @tparam R The record type
+     */
+    template<typename R>
+    struct is_packed_record : std::false_type { };
+
+    /**
+     * @brief Specialization of is_packed_record for std::array, whose elements are contiguous
+     */
+    template<typename T, size_t N>
+    struct is_packed_record<std::array<T, N>> : std::true_type { };
+
+    /**
+     * @brief A tuple-like record whose fields are stored in type list order, each at its natural alignment
+     *
+     * @details This is the default record type of serializer. Because the serializer knows where every field is stored, adjacent
+     * fields which need no conversion and have no padding between them are copied with a single memcpy, and records with no
+     * padding at all are copied whole. Fields are accessed with ```get<I>``` or structured bindings.
+     *
+     * A default constructed record has every byte zeroed, so field types do not need to be default constructible.
+     *
+     * @tparam TS The field types. Every type must be trivially copyable.
+     */
+    template<typename... TS>
+    class field_record {
+        static_assert(type_list<TS...>.all_of(func<std::is_trivially_copyable>), "Cannot store non-trivially copyable fields");
+
+        using layout_t = detail::field_record_layout<TS...>;
+
+    public:
+        /**
+         * @brief Constructs a record with every byte zeroed
+         */
+        field_record() = default;
+
+        /**
+         * @brief Constructs a record from a value for each field
+         */
+        template<bool B = (sizeof...(TS) > 0), std::enable_if_t<B, int> = 0>
+        field_record(const TS&... values) {
+            size_t i = 0;
+            ((std::memcpy(storage_ + layout_t::bounds[i++], std::addressof(values), sizeof(TS))), ...);
+        }
+
+        /**
+         * @brief Returns the byte offset of the field at index I within the record
+         */
+        template<size_t I>
+        static constexpr size_t offset(index_t<I> /* index */) {
+            static_assert(I < sizeof...(TS), "Cannot access out of range index of field_record");
+            return layout_t::bounds[I];
+        }
+
+        template<size_t I, typename... US>
+        friend auto& get(field_record<US...>& record);
+
+        template<size_t I, typename... US>
+        friend const auto& get(const field_record<US...>& record);
+
+        friend bool operator==(const field_record& lhs, const field_record& rhs) {
+            return lhs.equal(rhs, std::make_index_sequence<sizeof...(TS)>());
+        }
+
+        friend bool operator!=(const field_record& lhs, const field_record& rhs) { return !(lhs == rhs); }
+
+    private:
+        template<size_t... IS>
+        bool equal([[maybe_unused]] const field_record& other, std::index_sequence<IS...> /* indices */) const {
+            return ((get<IS>(*this) == get<IS>(other)) && ... && true);
+        }
+
+        // Trivially copyable fields are created implicitly in the byte storage when it is written
+        alignas(layout_t::align) unsigned char storage_[layout_t::size] { };
+    };
+
+    /**
+     * @brief Returns a reference to the field at index I of a field_record
+     */
+    template<size_t I, typename... TS>
+    auto& get(field_record<TS...>& record) {
+        using T = detail::type_list_element_t<I, TS...>;
+        return *std::launder(reinterpret_cast<T*>(record.storage_ + field_record<TS...>::offset(index<I>)));
+    }
+
+    /**
+     * @brief Returns a const reference to the field at index I of a field_record
+     */
+    template<size_t I, typename... TS>
+    const auto& get(const field_record<TS...>& record) {
+        using T = detail::type_list_element_t<I, TS...>;
+        return *std::launder(reinterpret_cast<const T*>(record.storage_ + field_record<TS...>::offset(index<I>)));
+    }
+}
+
+/**
+ * @cond TURN_OFF_DOXYGEN
+ */
+namespace std {
+    template<typename... TS>
+    struct tuple_size<kt::field_record<TS...>> : integral_constant<size_t, sizeof...(TS)> { };
+
+    template<size_t I, typename... TS>
+    struct tuple_element<I, kt::field_record<TS...>> {
+        using type = kt::detail::type_list_element_t<I, TS...>;
+    };
+}
+/**
+ * @endcond
+ */
+
+namespace kt {
+    /**
+     * @brief Encodes and decodes records whose fields are described by a type list to and from a fixed binary layout
+     *
+     * @details The wire layout is computed at compile time: fields are packed back to back in type list order with no padding,
+     * and arithmetic and enum fields are stored little-endian. Byte order conversion is only emitted for those fields, and only
+     * on big-endian hosts. Other trivially copyable types are copied as-is.
+     *
+     * Records can be any tuple-like type supporting ```get<I>``` whose elements match the type list, such as field_record,
+     * std::tuple, or std::array. For field_record, the default record type, and for record types marked with is_packed_record,
+     * adjacent fields which need no conversion and have no padding between them are copied with a single memcpy, and records and
+     * batches which need no conversion and have no padding at all are copied with one memcpy. Other records are copied field by
+     * field.
+     *
+     * @tparam TL The type_list_t describing the fields. Every type must be trivially copyable.
+     */
+    template<typename TL>
+    class serializer;
+
+    /**
+     * @brief Specialization of serializer for a type_list_t
+     *
+     * @tparam TS The field types
+     */
+    template<typename... TS>
+    class serializer<type_list_t<TS...>> {
+        static_assert(type_list<TS...>.all_of(func<std::is_trivially_copyable>), "Cannot serialize non-trivially copyable types");
+
+        using layout_t  = detail::serializer_layout<TS...>;
+        using indices_t = std::make_index_sequence<sizeof...(TS)>;
+
+        // Where a record type stores its fields, and so which fields can be copied together
+        template<typename R>
+        struct record_layout {
+            static constexpr bool packed = is_packed_record<R>::value;
+            static constexpr bool known  = packed || detail::serializer_record_offsets<R>::known;
+
+            static constexpr std::array<size_t, sizeof...(TS)> offsets = [] {
+                if constexpr(packed) {
+                    return layout_t::offsets;
+                }
+                else {
+                    std::array<size_t, sizeof...(TS)> out { };
+                    if constexpr(known) {
+                        for(size_t i = 0; i < out.size(); ++i) {
+                            out[i] = detail::serializer_record_offsets<R>::bounds[i];
+                        }
+                    }
+                    return out;
+                }
+            }();
+
+            static constexpr detail::serializer_runs<sizeof...(TS)> runs =
+                detail::serializer_make_runs<sizeof...(TS)>(layout_t::sizes, layout_t::swaps, offsets, known);
+
+            static constexpr bool mergeable(size_t i) { return runs.start[i] == i && runs.end[i] - i > 1; }
+
+            // If every field is in one run and the record has no tail padding, the record's bytes are its wire layout
+            static constexpr bool copy_whole =
+                known && (sizeof...(TS) == 0 || runs.end[0] == sizeof...(TS)) && sizeof(R) == layout_t::wire_size;
+        };
+
+    public:
+        /**
+         * @brief The default record type produced when decoding
+         */
+        using record_type = field_record<TS...>;
+
+        /**
+         * @brief The number of bytes one record occupies on the wire
+         */
+        static constexpr size_t wire_size = layout_t::wire_size;
+
+        /**
+         * @brief Returns the byte offset of the field at index I within an encoded record
+         */
+        template<size_t I>
+        static constexpr size_t offset(index_t<I> /* index */) {
+            static_assert(I < sizeof...(TS), "Cannot access out of range index of serializer");
+            return layout_t::offsets[I];
+        }
+
+        /**
+         * @brief Encodes a record into wire_size bytes at out
+         */
+        template<typename R = record_type>
+        static void encode(const R& record, void* out) {
+            check_record<R>();
+            check_offsets(record);
+            encode_one(record, static_cast<unsigned char*>(out));
+        }
+
+        /**
+         * @brief Decodes wire_size bytes at in into a record
+         */
+        template<typename R = record_type>
+        static void decode(const void* in, R& record) {
+            check_record<R>();
+            check_offsets(record);
+            decode_one(static_cast<const unsigned char*>(in), record);
+        }
+
+        /**
+         * @brief Decodes wire_size bytes at in into a new record
+         */
+        static record_type decode(const void* in) {
+            record_type record;
+            decode(in, record);
+            return record;
+        }
+
+        /**
+         * @brief Encodes count contiguous records into count * wire_size bytes at out
+         */
+        template<typename R = record_type>
+        static void encode_batch(const R* records, size_t count, void* out) {
+            check_record<R>();
+            if(count == 0) {
+                return;
+            }
+            check_offsets(records[0]);
+            if constexpr(record_layout<R>::copy_whole) {
+                std::memcpy(out, records, count * wire_size);
+            }
+            else {
+                auto* bytes = static_cast<unsigned char*>(out);
+                for(size_t i = 0; i < count; ++i) {
+                    encode_one(records[i], bytes + i * wire_size);
+                }
+            }
+        }
+
+        /**
+         * @brief Decodes count * wire_size bytes at in into count contiguous records
+         */
+        template<typename R = record_type>
+        static void decode_batch(const void* in, size_t count, R* records) {
+            check_record<R>();
+            if(count == 0) {
+                return;
+            }
+            check_offsets(records[0]);
+            if constexpr(record_layout<R>::copy_whole) {
+                std::memcpy(records, in, count * wire_size);
+            }
+            else {
+                const auto* bytes = static_cast<const unsigned char*>(in);
+                for(size_t i = 0; i < count; ++i) {
+                    decode_one(bytes + i * wire_size, records[i]);
+                }
+            }
+        }
+
+    private:
+        template<typename R>
+        static constexpr void check_record() {
+            static_assert(std::tuple_size<R>::value == sizeof...(TS), "Record does not have one element per serializer field");
+            static_assert(check_elements<R>(indices_t()), "Record element types do not match the serializer fields");
+            static_assert(!is_packed_record<R>::value || sizeof(R) >= wire_size, "Packed record is smaller than the wire size");
+        }
+
+        // Records marked with is_packed_record are trusted to store their fields at the wire offsets, so debug builds check them
+        template<typename R>
+        static void check_offsets([[maybe_unused]] const R& record) {
+#ifndef NDEBUG
+            if constexpr(is_packed_record<R>::value) {
+                assert(has_wire_offsets(record, indices_t()) && "Packed record does not store its fields at the wire offsets");
+            }
+#endif
+        }
+
+        template<typename R, size_t... IS>
+        static bool has_wire_offsets([[maybe_unused]] const R& record, std::index_sequence<IS...> /* indices */) {
+            using std::get;
+            [[maybe_unused]] const auto* base = reinterpret_cast<const unsigned char*>(std::addressof(record));
+            return ((reinterpret_cast<const unsigned char*>(std::addressof(get<IS>(record))) - base ==
+                     static_cast<std::ptrdiff_t>(layout_t::offsets[IS])) &&
+                    ... && true);
+        }
+
+        template<typename R, size_t... IS>
+        static constexpr bool check_elements(std::index_sequence<IS...> /* indices */) {
+            return (std::is_same_v<std::tuple_element_t<IS, R>, TS> && ... && true);
+        }
+
+        template<typename R>
+        static void encode_one(const R& record, unsigned char* out) {
+            if constexpr(record_layout<R>::copy_whole) {
+                std::memcpy(out, std::addressof(record), wire_size);
+            }
+            else {
+                encode_fields(record, out, indices_t());
+            }
+        }
+
+        template<typename R>
+        static void decode_one(const unsigned char* in, R& record) {
+            if constexpr(record_layout<R>::copy_whole) {
+                std::memcpy(std::addressof(record), in, wire_size);
+            }
+            else {
+                decode_fields(in, record, indices_t());
+            }
+        }
+
+        template<typename R, size_t... IS>
+        static void encode_fields([[maybe_unused]] const R& record,
+                                  [[maybe_unused]] unsigned char* out,
+                                  std::index_sequence<IS...> /* indices */) {
+            (encode_field<IS>(record, out), ...);
+        }
+
+        template<typename R, size_t... IS>
+        static void decode_fields([[maybe_unused]] const unsigned char* in,
+                                  [[maybe_unused]] R& record,
+                                  std::index_sequence<IS...> /* indices */) {
+            (decode_field<IS>(in, record), ...);
+        }
+
+        // Fields after the start of a run are copied along with the start of the run
+        template<size_t I, typename R>
+        static void encode_field(const R& record, unsigned char* out) {
+            using std::get;
+            if constexpr(record_layout<R>::runs.start[I] == I) {
+                if constexpr(record_layout<R>::mergeable(I)) {
+                    std::memcpy(out + layout_t::offsets[I], &get<I>(record), run_bytes<R>(I));
+                }
+                else {
+                    detail::serializer_store(out + layout_t::offsets[I], get<I>(record));
+                }
+            }
+        }
+
+        template<size_t I, typename R>
+        static void decode_field(const unsigned char* in, R& record) {
+            using std::get;
+            if constexpr(record_layout<R>::runs.start[I] == I) {
+                if constexpr(record_layout<R>::mergeable(I)) {
+                    std::memcpy(&get<I>(record), in + layout_t::offsets[I], run_bytes<R>(I));
+                }
+                else {
+                    detail::serializer_load(in + layout_t::offsets[I], get<I>(record));
+                }
+            }
+        }
+
+        template<typename R>
+        static constexpr size_t run_bytes(size_t start) {
+            const size_t end = record_layout<R>::runs.end[start];
+            return (end == sizeof...(TS) ? wire_size : layout_t::offsets[end]) - layout_t::offsets[start];
+        }
+    };
+
+    /**
+     * @brief A read-only view of one encoded record, which loads fields straight from the byte buffer
+     *
+     * @tparam TL The type_list_t describing the fields, matching the serializer used to encode the buffer
+     */
+    template<typename TL>
+    class view;
+
+    /**
+     * @brief Specialization of view for a type_list_t
+     *
+     * @tparam TS The field types
+     */
+    template<typename... TS>
+    class view<type_list_t<TS...>> {
+    public:
+        /**
+         * @brief Constructs a view of the encoded record starting at data
+         */
+        explicit view(const void* data) : data_(static_cast<const unsigned char*>(data)) { }
+
+        /**
+         * @brief Returns the number of bytes in the viewed record
+         */
+        static constexpr size_t size() { return serializer<type_list_t<TS...>>::wire_size; }
+
+        /**
+         * @brief Returns a pointer to the start of the viewed record
+         */
+        const void* data() const { return data_; }
+
+        /**
+         * @brief Returns the value of the field at index I
+         *
+         * @note Calling this function will give a compile error if the index is out of range
+         */
+        template<size_t I>
+        auto get(index_t<I> /* index */) const {
+            static_assert(I < sizeof...(TS), "Cannot access out of range index of view");
+            return detail::serializer_read<detail::type_list_element_t<I, TS...>>(data_ + serializer<type_list_t<TS...>>::offset(index<I>));
+        }
+
+        /**
+         * @brief Returns a view of the record immediately following this one, for walking a batch of encoded records
+         */
+        view next() const { return view(data_ + size()); }
+
+    private:
+        const unsigned char* data_;
+    };
+}
+
+#endif
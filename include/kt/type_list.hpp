@@ -24,8 +24,10 @@ SOFTWARE.
 #ifndef KT_TYPE_LIST_HPP
 #define KT_TYPE_LIST_HPP
 
+#include <array>
 #include <cstddef>
 #include <limits>
+#include <type_traits>
 #include <utility>
 
 namespace kt {
@@ -118,6 +120,50 @@ namespace kt {
     template<template<typename> class F>
     constexpr func_t<F> func = func_t<F>();
 
+    /**
+     * @brief Template wrapper for templated metafunctions which take an index and a type
+     *
+     * @details The metafunction is instantiated as ```F<index_t<I>, T>```, where I is the index of T in the type list
+     *
+     * @tparam F The unspecialized metafunction
+     */
+    template<template<typename, typename> class F>
+    struct func_i_t {
+        /**
+         * @brief Constructs the func_i_t
+         */
+        constexpr explicit func_i_t() = default;
+    };
+
+    /**
+     * @relates func_i_t
+     *
+     * @brief Global instantiation of func_i_t<F>
+     */
+    template<template<typename, typename> class F>
+    constexpr func_i_t<F> func_i = func_i_t<F>();
+
+    /**
+     * @brief Template wrapper for templated metafunctions which take two types
+     *
+     * @tparam F The unspecialized metafunction
+     */
+    template<template<typename, typename> class F>
+    struct func2_t {
+        /**
+         * @brief Constructs the func2_t
+         */
+        constexpr explicit func2_t() = default;
+    };
+
+    /**
+     * @relates func2_t
+     *
+     * @brief Global instantiation of func2_t<F>
+     */
+    template<template<typename, typename> class F>
+    constexpr func2_t<F> func2 = func2_t<F>();
+
     /**
      * @brief Template wrapper for an unsigned integer index
      *
@@ -147,6 +193,21 @@ namespace kt {
      */
     static constexpr size_t npos = std::numeric_limits<size_t>::max();
 
+    /**
+     * @brief Aggregate layout properties of the types in a type list
+     *
+     * @tparam N The number of types in the type list
+     */
+    template<size_t N>
+    struct type_list_layout_t {
+        size_t max_size    = 0; /**< The largest sizeof of any type, or 0 for an empty type list */
+        size_t max_align   = 1; /**< The largest alignof of any type, or 1 for an empty type list */
+        size_t packed_size = 0; /**< The sum of the sizes of all types */
+        std::array<size_t, N> offsets { }; /**< The offset of each type when all types are packed back to back without padding */
+        bool trivially_destructible = true; /**< If every type is trivially destructible */
+        bool trivially_copyable     = true; /**< If every type is trivially copyable */
+    };
+
     template<typename... TS>
     struct type_list_t;
 
@@ -226,6 +287,11 @@ namespace kt {
         struct type_list_filter_tag { };
         struct type_list_filter_range_tag { };
         struct type_list_pop_back_tag { };
+        struct type_list_apply_indexed_tag { };
+        struct type_list_filter_indexed_tag { };
+        struct type_list_all_of_tag { };
+        struct type_list_any_of_tag { };
+        struct type_list_find_if_tag { };
 
         template<typename T, typename TL, typename TAG, typename = std::make_index_sequence<TL().size()>>
         struct type_list_with_iseq;
@@ -256,6 +322,104 @@ namespace kt {
 
         template<typename TL>
         using type_list_pop_back_t = typename type_list_with_iseq<void, TL, type_list_pop_back_tag>::type;
+
+        template<template<typename, typename> class F, typename TL>
+        using type_list_apply_indexed_t = typename type_list_with_iseq<func_i_t<F>, TL, type_list_apply_indexed_tag>::type;
+
+        template<template<typename, typename> class F, typename TL>
+        using type_list_filter_indexed_t = typename type_list_with_iseq<func_i_t<F>, TL, type_list_filter_indexed_tag>::type;
+
+        // Wraps F<T> for std::disjunction so the index of the first true result can be read back from it
+        template<size_t I, typename B>
+        struct type_list_find_if_probe {
+            static constexpr bool value   = static_cast<bool>(B::value);
+            static constexpr size_t index = I;
+        };
+
+        // The short-circuiting queries are evaluated in blocks of up to 32 types, each block being a single std::conjunction or
+        // std::disjunction. The query over the types after a block is only instantiated if that block was not decisive, so the
+        // instantiation depth grows with the number of blocks instead of the number of types
+        template<typename TAG>
+        struct type_list_query_end;
+
+        template<>
+        struct type_list_query_end<type_list_all_of_tag> : std::true_type { };
+
+        template<>
+        struct type_list_query_end<type_list_any_of_tag> : std::false_type { };
+
+        template<>
+        struct type_list_query_end<type_list_find_if_tag> : type_list_find_if_probe<npos, std::true_type> { };
+
+        template<typename TAG, template<typename> class F, size_t OFFSET, typename ISEQ, typename REST, typename... TS>
+        struct type_list_query_block;
+
+        template<template<typename> class F, size_t OFFSET, size_t... IS, typename REST, typename... TS>
+        struct type_list_query_block<type_list_all_of_tag, F, OFFSET, std::index_sequence<IS...>, REST, TS...> {
+            using type = std::conjunction<std::conjunction<F<TS>...>, REST>;
+        };
+
+        template<template<typename> class F, size_t OFFSET, size_t... IS, typename REST, typename... TS>
+        struct type_list_query_block<type_list_any_of_tag, F, OFFSET, std::index_sequence<IS...>, REST, TS...> {
+            using type = std::disjunction<std::disjunction<F<TS>...>, REST>;
+        };
+
+        template<template<typename> class F, size_t OFFSET, size_t... IS, typename REST, typename... TS>
+        struct type_list_query_block<type_list_find_if_tag, F, OFFSET, std::index_sequence<IS...>, REST, TS...> {
+            using type = std::disjunction<std::disjunction<type_list_find_if_probe<OFFSET + IS, F<TS>>...>, REST>;
+        };
+
+        template<typename TAG, template<typename> class F, size_t OFFSET, typename... TS>
+        struct type_list_query :
+            type_list_query_block<TAG, F, OFFSET, std::index_sequence_for<TS...>, type_list_query_end<TAG>, TS...>::type { };
+
+        template<typename TAG,
+                 template<typename> class F,
+                 size_t OFFSET,
+                 typename T0, typename T1, typename T2, typename T3, typename T4, typename T5, typename T6, typename T7,
+                 typename T8, typename T9, typename T10, typename T11, typename T12, typename T13, typename T14, typename T15,
+                 typename T16, typename T17, typename T18, typename T19, typename T20, typename T21, typename T22, typename T23,
+                 typename T24, typename T25, typename T26, typename T27, typename T28, typename T29, typename T30, typename T31,
+                 typename... TS>
+        struct type_list_query<TAG,
+                               F,
+                               OFFSET,
+                               T0, T1, T2, T3, T4, T5, T6, T7,
+                               T8, T9, T10, T11, T12, T13, T14, T15,
+                               T16, T17, T18, T19, T20, T21, T22, T23,
+                               T24, T25, T26, T27, T28, T29, T30, T31,
+                               TS...> :
+            type_list_query_block<TAG,
+                                  F,
+                                  OFFSET,
+                                  std::make_index_sequence<32>,
+                                  type_list_query<TAG, F, OFFSET + 32, TS...>,
+                                  T0, T1, T2, T3, T4, T5, T6, T7,
+                                  T8, T9, T10, T11, T12, T13, T14, T15,
+                                  T16, T17, T18, T19, T20, T21, T22, T23,
+                                  T24, T25, T26, T27, T28, T29, T30, T31>::type { };
+
+        template<typename A, typename B>
+        struct type_list_pair {
+            using type = type_list_t<A, B>;
+        };
+
+        template<size_t N>
+        constexpr type_list_layout_t<N> type_list_make_layout(const std::array<size_t, N>& sizes,
+                                                              const std::array<size_t, N>& aligns,
+                                                              bool trivially_destructible,
+                                                              bool trivially_copyable) {
+            type_list_layout_t<N> out;
+            for(size_t i = 0; i < N; ++i) {
+                out.offsets[i]  = out.packed_size;
+                out.packed_size += sizes[i];
+                out.max_size    = sizes[i] > out.max_size ? sizes[i] : out.max_size;
+                out.max_align   = aligns[i] > out.max_align ? aligns[i] : out.max_align;
+            }
+            out.trivially_destructible = trivially_destructible;
+            out.trivially_copyable     = trivially_copyable;
+            return out;
+        }
     }
     /**
      * @endcond
@@ -379,6 +543,20 @@ namespace kt {
             }
         }
 
+        /**
+         * @brief Applies a metafunction to each type in the type list along with its index
+         *
+         * @details The metafunction is applied to each type in the type list as ```typename F<index_t<I>, T>::type```
+         *
+         * @tparam F The metafunction to apply
+         *
+         * @return A new type list, with the metafunction applied to each element of the old type list
+         */
+        template<template<typename, typename> class F>
+        constexpr auto apply_indexed(func_i_t<F> /* functor */) const {
+            return detail::type_list_apply_indexed_t<F, type_list_t<TS...>>();
+        }
+
         /**
          * @brief Filters out all types where the given metafunction returns false
          *
@@ -393,6 +571,20 @@ namespace kt {
             return detail::type_list_filter_t<F, type_list_t<TS...>>();
         }
 
+        /**
+         * @brief Filters out all types where the given metafunction returns false when given the type and its index
+         *
+         * @details The metafunction is applied to each type as ```F<index_t<I>, T>::value```
+         *
+         * @tparam F The metafunction used to filter
+         *
+         * @return A new type list with all elements in which the given metafunction returned true
+         */
+        template<template<typename, typename> class F>
+        constexpr auto filter_indexed(func_i_t<F> /* functor */) const {
+            return detail::type_list_filter_indexed_t<F, type_list_t<TS...>>();
+        }
+
         /**
          * @brief Filters out all types in the given index range where the given metafunction returns false
          *
@@ -574,6 +766,89 @@ namespace kt {
             return (F<TS>::value || ... || false);
         }
 
+        /**
+         * @brief Returns if the given metafunction evaluates to true for all types in the type list, stopping at the first false result
+         *
+         * @details The metafunction is applied to each type in the type list as ```F<T>::value``` through ```std::conjunction```, so
+         * F is not instantiated for any type after the first one where it evaluates to false. For empty type lists, this will always
+         * return true
+         *
+         * @tparam F The metafunction
+         */
+        template<template<typename> class F>
+        constexpr bool all_of_lazy(func_t<F> /* functor */) const {
+            return detail::type_list_query<detail::type_list_all_of_tag, F, 0, TS...>::value;
+        }
+
+        /**
+         * @brief Returns if the given metafunction evaluates to true for at least one type in the type list, stopping at the first true
+         * result
+         *
+         * @details The metafunction is applied to each type in the type list as ```F<T>::value``` through ```std::disjunction```, so
+         * F is not instantiated for any type after the first one where it evaluates to true. For empty type lists, this will always
+         * return false
+         *
+         * @tparam F The metafunction
+         */
+        template<template<typename> class F>
+        constexpr bool any_of(func_t<F> /* functor */) const {
+            return detail::type_list_query<detail::type_list_any_of_tag, F, 0, TS...>::value;
+        }
+
+        /**
+         * @brief Returns if the given metafunction evaluates to false for all types in the type list, stopping at the first true result
+         *
+         * @details Equivalent to ```!any_of(func<F>)```. For empty type lists, this will always return true
+         *
+         * @tparam F The metafunction
+         */
+        template<template<typename> class F>
+        constexpr bool none_of(func_t<F> /* functor */) const {
+            return !detail::type_list_query<detail::type_list_any_of_tag, F, 0, TS...>::value;
+        }
+
+        /**
+         * @brief Returns the number of types in the type list for which the given metafunction evaluates to true
+         *
+         * @details The metafunction is applied to each type in the type list as ```F<T>::value```. Every type has to be visited to
+         * produce the count, so F is instantiated for all of them
+         *
+         * @tparam F The metafunction
+         */
+        template<template<typename> class F>
+        constexpr size_t count_if(func_t<F> /* functor */) const {
+            return ((F<TS>::value ? size_t(1) : size_t(0)) + ... + size_t(0));
+        }
+
+        /**
+         * @brief Returns the index of the first type in the type list for which the given metafunction evaluates to true
+         *
+         * @details The metafunction is applied to each type in the type list as ```F<T>::value``` through ```std::disjunction```, so
+         * F is not instantiated for any type after the first one where it evaluates to true
+         *
+         * @tparam F The metafunction
+         *
+         * @return The index of the first matching type, or npos if no type matches
+         */
+        template<template<typename> class F>
+        constexpr size_t find_if(func_t<F> /* functor */) const {
+            return detail::type_list_query<detail::type_list_find_if_tag, F, 0, TS...>::index;
+        }
+
+        /**
+         * @brief Returns the aggregate layout properties of the types in the type list
+         *
+         * @details All properties are computed in a single pass over the type list. See type_list_layout_t for the reported values.
+         *
+         * @note Calling this function will give a compile error if any type in the type list is incomplete
+         */
+        constexpr type_list_layout_t<sizeof...(TS)> layout() const {
+            return detail::type_list_make_layout<sizeof...(TS)>({ { sizeof(TS)... } },
+                                                               { { alignof(TS)... } },
+                                                               (std::is_trivially_destructible_v<TS> && ... && true),
+                                                               (std::is_trivially_copyable_v<TS> && ... && true));
+        }
+
         /**
          * @brief Appends the given type to the end of the type list
          *
@@ -689,6 +964,18 @@ namespace kt {
         struct type_list_with_iseq<void, type_list_t<TS...>, type_list_pop_back_tag, std::index_sequence<IS...>> {
             using type = decltype((type_list_t<>() + ... + std::conditional_t<(IS == sizeof...(IS) - 1), tag_t<ignore_t>, tag_t<TS>>()));
         };
+
+        // type_list_t::apply_indexed implementation
+        template<template<typename, typename> class F, typename... TS, size_t... IS>
+        struct type_list_with_iseq<func_i_t<F>, type_list_t<TS...>, type_list_apply_indexed_tag, std::index_sequence<IS...>> {
+            using type = type_list_t<typename F<index_t<IS>, TS>::type...>;
+        };
+
+        // type_list_t::filter_indexed implementation
+        template<template<typename, typename> class F, typename... TS, size_t... IS>
+        struct type_list_with_iseq<func_i_t<F>, type_list_t<TS...>, type_list_filter_indexed_tag, std::index_sequence<IS...>> {
+            using type = decltype((type_list_t<>() + ... + std::conditional_t<F<index_t<IS>, TS>::value, tag_t<TS>, tag_t<ignore_t>>()));
+        };
     }
     /**
      * @endcond
@@ -701,6 +988,49 @@ namespace kt {
      */
     template<typename... TS>
     constexpr type_list_t<TS...> type_list = type_list_t<TS...>();
+
+    /**
+     * @relates type_list_t
+     *
+     * @brief Applies a metafunction to each pair of types at the same index in two type lists
+     *
+     * @details The metafunction is applied to each pair of types as ```typename F<A, B>::type```
+     *
+     * @tparam AS The types in the first type list
+     * @tparam BS The types in the second type list
+     * @tparam F The metafunction to apply
+     *
+     * @return A new type list, with the metafunction applied to each pair of types
+     *
+     * @note Calling this function will give a compile error if the type lists are not the same size
+     */
+    template<typename... AS, typename... BS, template<typename, typename> class F>
+    constexpr auto zip_with(type_list_t<AS...> /* first */, type_list_t<BS...> /* second */, func2_t<F> /* functor */) {
+        static_assert(sizeof...(AS) == sizeof...(BS), "Cannot zip type lists of different sizes");
+        if constexpr(sizeof...(AS) == sizeof...(BS)) {
+            return type_list_t<typename F<AS, BS>::type...>();
+        }
+        else {
+            return type_list_t<>();
+        }
+    }
+
+    /**
+     * @relates type_list_t
+     *
+     * @brief Pairs up the types at the same index in two type lists
+     *
+     * @tparam AS The types in the first type list
+     * @tparam BS The types in the second type list
+     *
+     * @return A new type list, where each element is a ```type_list_t<A, B>``` of the types at that index
+     *
+     * @note Calling this function will give a compile error if the type lists are not the same size
+     */
+    template<typename... AS, typename... BS>
+    constexpr auto zip(type_list_t<AS...> first, type_list_t<BS...> second) {
+        return zip_with(first, second, func2<detail::type_list_pair>);
+    }
 }
 
 #endif
@@ -0,0 +1,502 @@
+/*
+MIT License
+
+Copyright (c) 2023 Kieran Hsieh
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+#ifndef KT_VALUE_LIST_HPP
+#define KT_VALUE_LIST_HPP
+
+#include <kt/type_list.hpp>
+
+#include <array>
+#include <cstddef>
+#include <type_traits>
+#include <utility>
+
+namespace kt {
+    /**
+     * @brief Template wrapper for a compile-time value
+     *
+     * @tparam V The value
+     */
+    template<auto V>
+    struct value_t {
+        static constexpr auto value = V; /**< The wrapped value */
+        using type                  = decltype(V); /**< The type of the wrapped value */
+
+        /**
+         * @brief Constructs the value_t
+         */
+        constexpr explicit value_t() = default;
+    };
+
+    /**
+     * @relates value_t
+     *
+     * @brief Global instantiation of value_t
+     */
+    template<auto V>
+    constexpr value_t<V> value = value_t<V>();
+
+    /**
+     * @brief Comparator which orders values of different types by value
+     *
+     * @details Behaves like std::less<>, except that integers of different signedness are compared by their mathematical value
+     * instead of after the usual arithmetic conversions, so -1 is less than 1u.
+     */
+    struct value_less {
+        /**
+         * @brief Returns if a is less than b
+         */
+        template<typename A, typename B>
+        constexpr bool operator()(const A& a, const B& b) const {
+            if constexpr(std::is_integral_v<A> && std::is_integral_v<B> && std::is_signed_v<A> != std::is_signed_v<B>) {
+                if constexpr(std::is_signed_v<A>) {
+                    return a < 0 || static_cast<std::make_unsigned_t<A>>(a) < b;
+                }
+                else {
+                    return b >= 0 && a < static_cast<std::make_unsigned_t<B>>(b);
+                }
+            }
+            else {
+                return a < b;
+            }
+        }
+    };
+
+    template<auto... VS>
+    struct value_list_t;
+
+    /**
+     * @cond TURN_OFF_DOXYGEN
+     */
+    namespace detail {
+        template<typename A, typename B>
+        constexpr bool value_list_equal(const A& a, const B& b) {
+            if constexpr(std::is_same_v<A, B>) {
+                return a == b;
+            }
+            else {
+                return false;
+            }
+        }
+
+        template<size_t I, auto... VS>
+        constexpr auto value_list_element_v = type_list_element_t<I, value_t<VS>...>::value;
+
+        template<typename ISEQ, auto... VS>
+        struct value_list_with_iseq;
+
+        template<size_t... IS, auto... VS>
+        struct value_list_with_iseq<std::index_sequence<IS...>, VS...> {
+            template<typename T>
+            static constexpr size_t first_index_of(const T& v) {
+                size_t index = npos;
+                ((index == npos && value_list_equal(VS, v) ? (void) (index = IS) : (void) 0), ...);
+                return index;
+            }
+
+            // The comparator is applied to every pair of values in their original types, and the results are looked up while sorting
+            template<typename C, auto V>
+            static constexpr std::array<bool, sizeof...(VS)> less_row { { C()(V, VS)... } };
+
+            template<typename C>
+            static constexpr std::array<std::array<bool, sizeof...(VS)>, sizeof...(VS)> less_table { { less_row<C, VS>... } };
+
+            template<typename C>
+            static constexpr std::array<size_t, sizeof...(VS)> sorted_order() {
+                std::array<size_t, sizeof...(VS)> order { { IS... } };
+                // Insertion sort keeps the result stable and is usable in constant expressions
+                for(size_t i = 1; i < order.size(); ++i) {
+                    const size_t cur = order[i];
+                    size_t j         = i;
+                    for(; j > 0 && less_table<C>[cur][order[j - 1]]; --j) {
+                        order[j] = order[j - 1];
+                    }
+                    order[j] = cur;
+                }
+                return order;
+            }
+
+            template<typename C>
+            static constexpr std::array<size_t, sizeof...(VS)> order_v = sorted_order<C>();
+
+            template<typename C>
+            using sort_type = value_list_t<value_list_element_v<order_v<C>[IS], VS...>...>;
+        };
+
+        template<auto... VS>
+        using value_list_iseq_t = value_list_with_iseq<std::make_index_sequence<sizeof...(VS)>, VS...>;
+
+        // Kept out of value_list_with_iseq so that index_of and sort do not pay for the pairwise comparisons it needs
+        template<typename ISEQ, auto... VS>
+        struct value_list_unique;
+
+        template<size_t... IS, auto... VS>
+        struct value_list_unique<std::index_sequence<IS...>, VS...> {
+            using type = decltype((value_list_t<>() + ... +
+                                   std::conditional_t<value_list_iseq_t<VS...>::first_index_of(VS) == IS, value_t<VS>, ignore_t>()));
+        };
+
+        template<auto... VS>
+        using value_list_unique_t = typename value_list_unique<std::make_index_sequence<sizeof...(VS)>, VS...>::type;
+    }
+    /**
+     * @endcond
+     */
+
+    /**
+     * @brief A metaprogramming construct representing a list of compile-time values
+     *
+     * @details Mirrors the interface of type_list_t. Each element keeps its own type, so two elements are only considered equal if
+     * they have the same type and compare equal.
+     *
+     * @tparam VS The values in the value list
+     */
+    template<auto... VS>
+    struct value_list_t {
+    private:
+        template<size_t I>
+        static constexpr bool index_in_range(index_t<I> /* index */) {
+            return I < sizeof...(VS);
+        }
+
+    public:
+        /**
+         * @brief Constructs the value_list_t
+         */
+        constexpr explicit value_list_t() = default;
+
+        /**
+         * @brief Returns the number of elements in the value list
+         */
+        constexpr size_t size() const { return sizeof...(VS); }
+
+        /**
+         * @brief Returns if the value list contains no elements
+         */
+        constexpr bool empty() const { return sizeof...(VS) == 0; }
+
+        /**
+         * @brief Returns the first value in the value list
+         *
+         * @note Calling this function give a compiler error if the value list is empty
+         */
+        constexpr auto front() const { return at(index<0>); }
+
+        /**
+         * @brief Returns the last value in the value list
+         *
+         * @note Calling this function give a compiler error if the value list is empty
+         */
+        constexpr auto back() const { return at(index<sizeof...(VS) - 1>); }
+
+        /**
+         * @brief Returns the ith value of the value list, where i is a 0-based index.
+         *
+         * @note Calling this function give a compiler error if the given index is out of range for the calling value list
+         */
+        template<size_t I>
+        constexpr auto at(index_t<I> /* index */) const {
+            static_assert(index_in_range(index<I>), "Cannot access out of range index of value list");
+            return detail::value_list_element_v<I, VS...>;
+        }
+
+        /**
+         * @brief Returns the index of a given value in the value list
+         *
+         * @tparam V The value to look up
+         *
+         * @note This will give a compile error if the provided value is not unique in the value list (count_of(value<V>) >= 2)
+         */
+        template<auto V>
+        constexpr size_t index_of(value_t<V> /* value */) const {
+            static_assert(value_list_t<VS...>().count_of(value<V>) < 2, "Cannot find index of non-unique value in value list");
+            return detail::value_list_iseq_t<VS...>::first_index_of(V);
+        }
+
+        /**
+         * @brief Returns the number of times a given value occurs in the value list
+         *
+         * @tparam V The value to count occurences of
+         */
+        template<auto V>
+        constexpr size_t count_of(value_t<V> /* value */) const {
+            return ((detail::value_list_equal(VS, V) ? 1 : 0) + ... + 0);
+        }
+
+        /**
+         * @brief Returns if the value list contains a given value
+         *
+         * @tparam V The value to check for
+         */
+        template<auto V>
+        constexpr bool contains(value_t<V> /* value */) const {
+            return (detail::value_list_equal(VS, V) || ... || false);
+        }
+
+        /**
+         * @brief Returns if the given predicate returns true for all values in the value list
+         *
+         * @details The predicate must be a stateless callable usable in constant expressions, such as a lambda without captures.
+         * For empty value lists, this will always return true
+         */
+        template<typename F>
+        constexpr bool all_of([[maybe_unused]] F pred) const {
+            return (pred(VS) && ... && true);
+        }
+
+        /**
+         * @brief Returns if the given predicate returns true for at least one value in the value list
+         *
+         * @details The predicate must be a stateless callable usable in constant expressions, such as a lambda without captures.
+         * For empty value lists, this will always return false
+         */
+        template<typename F>
+        constexpr bool one_of([[maybe_unused]] F pred) const {
+            return (pred(VS) || ... || false);
+        }
+
+        /**
+         * @brief Applies a callable to each value in the value list
+         *
+         * @details The callable must be stateless and usable in constant expressions, such as a lambda without captures.
+         *
+         * @return A new value list holding the result of the callable for each element of the old value list
+         */
+        template<typename F>
+        constexpr auto apply([[maybe_unused]] F func) const {
+            return value_list_t<func(VS)...>();
+        }
+
+        /**
+         * @brief Filters out all values where the given predicate returns false
+         *
+         * @details The predicate must be a stateless callable usable in constant expressions, such as a lambda without captures.
+         *
+         * @return A new value list with all elements for which the predicate returned true
+         */
+        template<typename F>
+        constexpr auto filter([[maybe_unused]] F pred) const {
+            return (value_list_t<>() + ... + std::conditional_t<pred(VS), value_t<VS>, detail::ignore_t>());
+        }
+
+        /**
+         * @brief Sorts the value list
+         *
+         * @details The sort is stable. Values are compared in their original types, and each element keeps its original type.
+         *
+         * @tparam C A default constructible comparator usable in constant expressions, such as value_less or std::greater<>.
+         * Comparators such as std::less<> apply the usual arithmetic conversions, so they misorder integers of different
+         * signedness, which value_less does not.
+         *
+         * @return A new value list with the values in sorted order
+         */
+        template<typename C = value_less>
+        constexpr auto sort(C /* comparator */ = C()) const {
+            if constexpr(sizeof...(VS) < 2) {
+                return *this;
+            }
+            else {
+                return typename detail::value_list_iseq_t<VS...>::template sort_type<C>();
+            }
+        }
+
+        /**
+         * @brief Removes every value which already occurred earlier in the value list
+         *
+         * @return A new value list containing the first occurence of each value, in their original order
+         */
+        constexpr auto unique() const { return detail::value_list_unique_t<VS...>(); }
+
+        /**
+         * @brief Appends a value to the end of the value list
+         *
+         * @tparam V The value to append
+         */
+        template<auto V>
+        constexpr auto append(value_t<V> /* value */) const {
+            return value_list_t<VS..., V>();
+        }
+
+        /**
+         * @brief Appends the values from another value list to the end of the calling value list
+         *
+         * @tparam OVS The values in the other value list
+         */
+        template<auto... OVS>
+        constexpr auto append(value_list_t<OVS...> /* value_list */) const {
+            return value_list_t<VS..., OVS...>();
+        }
+
+        /**
+         * @brief Prepends a value to the front of the value list
+         *
+         * @tparam V The value to prepend
+         */
+        template<auto V>
+        constexpr auto prepend(value_t<V> /* value */) const {
+            return value_list_t<V, VS...>();
+        }
+
+        /**
+         * @brief Prepends the values from another value list to the front of the calling value list
+         *
+         * @tparam OVS The values in the other value list
+         */
+        template<auto... OVS>
+        constexpr auto prepend(value_list_t<OVS...> /* value_list */) const {
+            return value_list_t<OVS..., VS...>();
+        }
+
+        /**
+         * @brief Returns the values as a std::array of their common type
+         *
+         * @note Calling this function will give a compile error if the value list is empty, use to_array(tag<T>) instead
+         */
+        constexpr auto to_array() const {
+            static_assert(sizeof...(VS) > 0, "Cannot deduce the element type of an empty value list");
+            return to_array(tag<std::common_type_t<decltype(VS)...>>);
+        }
+
+        /**
+         * @brief Returns the values as a std::array of the given type
+         *
+         * @tparam T The element type of the array
+         */
+        template<typename T>
+        constexpr std::array<T, sizeof...(VS)> to_array(tag_t<T> /* type */) const {
+            return { { static_cast<T>(VS)... } };
+        }
+
+        /**
+         * @brief Returns the values as a std::integer_sequence of their common type
+         *
+         * @note Calling this function will give a compile error if the value list is empty, use to_sequence(tag<T>) instead
+         */
+        constexpr auto to_sequence() const {
+            static_assert(sizeof...(VS) > 0, "Cannot deduce the element type of an empty value list");
+            return to_sequence(tag<std::common_type_t<decltype(VS)...>>);
+        }
+
+        /**
+         * @brief Returns the values as a std::integer_sequence of the given type
+         *
+         * @tparam T The integral type of the sequence
+         */
+        template<typename T>
+        constexpr auto to_sequence(tag_t<T> /* type */) const {
+            static_assert(std::is_integral_v<T>, "Cannot create an integer sequence of a non-integral type");
+            return std::integer_sequence<T, static_cast<T>(VS)...>();
+        }
+
+        /**
+         * @brief Returns a type list holding each value wrapped in a value_t
+         */
+        constexpr auto to_type_list() const { return type_list_t<value_t<VS>...>(); }
+
+        /**
+         * @brief Appends the given value to the end of the value list
+         *
+         * @tparam V The value to append
+         */
+        template<auto V>
+        constexpr auto operator+(value_t<V> /* value */) const {
+            return value_list_t<VS..., V>();
+        }
+
+        /**
+         * @brief Appends the values in another value list to the end of the value list
+         *
+         * @tparam OVS The values in the other value list
+         */
+        template<auto... OVS>
+        constexpr auto operator+(value_list_t<OVS...> /* other */) const {
+            return value_list_t<VS..., OVS...>();
+        }
+
+        /**
+         * @cond TURN_OFF_DOXYGEN
+         */
+        constexpr auto operator+(detail::ignore_t /* ignored */) const { return *this; }
+        /**
+         * @endcond
+         */
+
+        /**
+         * @brief Returns if both value lists hold values of the same types which compare equal, at the same indices
+         *
+         * @tparam OVS The values in the other value list
+         */
+        template<auto... OVS>
+        constexpr bool operator==(const value_list_t<OVS...>& /* other */) const {
+            if constexpr(sizeof...(VS) == sizeof...(OVS)) {
+                return (detail::value_list_equal(VS, OVS) && ... && true);
+            }
+            else {
+                return false;
+            }
+        }
+
+        /**
+         * @brief Returns if the value lists differ in size, or in the type or value of any element
+         *
+         * @tparam OVS The values in the other value list
+         */
+        template<auto... OVS>
+        constexpr bool operator!=(const value_list_t<OVS...>& other) const {
+            return !(*this == other);
+        }
+    };
+
+    /**
+     * @relates value_list_t
+     *
+     * @brief Global instantiation of a value_list_t
+     */
+    template<auto... VS>
+    constexpr value_list_t<VS...> value_list = value_list_t<VS...>();
+
+    /**
+     * @relates value_list_t
+     *
+     * @brief Creates a value list from a type list of value wrappers
+     *
+     * @details Each type in the type list must have a static ```value``` member, such as value_t, index_t, or
+     * std::integral_constant.
+     */
+    template<typename... TS>
+    constexpr auto to_value_list(type_list_t<TS...> /* type_list */) {
+        return value_list_t<TS::value...>();
+    }
+
+    /**
+     * @relates value_list_t
+     *
+     * @brief Creates a value list from a std::integer_sequence
+     */
+    template<typename T, T... VS>
+    constexpr auto to_value_list(std::integer_sequence<T, VS...> /* sequence */) {
+        return value_list_t<VS...>();
+    }
+}
+
+#endif
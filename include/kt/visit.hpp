@@ -0,0 +1,73 @@
+/*
+MIT License
+
+Copyright (c) 2023 Kieran Hsieh
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+#ifndef KT_VISIT_HPP
+#define KT_VISIT_HPP
+
+#include <kt/type_list.hpp>
+
+#include <cstddef>
+#include <type_traits>
+#include <utility>
+
+namespace kt {
+    /**
+     * @cond TURN_OFF_DOXYGEN
+     */
+    namespace detail {
+        template<typename T, typename F>
+        decltype(auto) visit_at_entry(F& f) {
+            return f(tag<T>);
+        }
+
+        template<typename F, typename... TS>
+        struct visit_at_table {
+            using result_t = decltype(std::declval<F&>()(tag<type_list_first_type_t<TS...>>));
+            using entry_t  = result_t (*)(F&);
+
+            static constexpr entry_t entries[] = { &visit_at_entry<TS, F>... };
+        };
+    }
+    /**
+     * @endcond
+     */
+
+    /**
+     * @brief Calls f with the tag_t of the type at a runtime index of a type list
+     *
+     * @details The call goes through a jump table generated from the type list, so the cost is one indirect call regardless of
+     * the list's size. f must return the same type for every tag.
+     *
+     * @param index The index of the type to visit. Must be less than the size of the type list.
+     * @param f The callable, invoked as ```f(tag<T>)```
+     *
+     * @return The result of f
+     */
+    template<typename... TS, typename F>
+    decltype(auto) visit_at(type_list_t<TS...> /* type_list */, size_t index, F&& f) {
+        static_assert(sizeof...(TS) > 0, "Cannot visit an empty type list");
+        return detail::visit_at_table<std::remove_reference_t<F>, TS...>::entries[index](f);
+    }
+}
+
+#endif
@@ -0,0 +1,162 @@
+/*
+MIT License
+
+Copyright (c) 2023 Kieran Hsieh
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+#include <kt/channel.hpp>
+#include <catch2/catch_test_macros.hpp>
+
+#include <algorithm>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace {
+    struct tick {
+        int producer;
+        int seq;
+    };
+
+    struct text {
+        std::string value;
+    };
+
+    using messages = kt::type_list_t<tick, text, double>;
+
+    struct fragile {
+        explicit fragile(int initial) : value(initial) { }
+        fragile(const fragile& other) : value(other.value) {
+            if(value < 0) {
+                throw std::runtime_error("fragile copy");
+            }
+        }
+
+        int value;
+    };
+}
+
+TEST_CASE("channel sizes slots from the message types", "[channel]") {
+    using ch = kt::channel<messages>;
+    REQUIRE(ch::message_size == std::max({ sizeof(tick), sizeof(text), sizeof(double) }));
+    REQUIRE(ch::message_align == std::max({ alignof(tick), alignof(text), alignof(double) }));
+    REQUIRE(sizeof(ch::index_type) == 1);
+    REQUIRE(ch(5).capacity() == 8);
+    REQUIRE(ch(1).capacity() == 2);
+}
+
+TEST_CASE("channel delivers messages in push order", "[channel]") {
+    kt::channel<messages> ch(4);
+    REQUIRE(ch.try_push(tick { 0, 1 }));
+    REQUIRE(ch.try_push(text { "hello" }));
+    REQUIRE(ch.try_emplace(kt::tag<double>, 2.5));
+    REQUIRE(ch.try_push(tick { 0, 2 }));
+    REQUIRE(!ch.try_push(tick { 0, 3 }));
+
+    std::string order;
+    struct visitor {
+        std::string& order;
+        void operator()(tick& t) const { order += "t" + std::to_string(t.seq); }
+        void operator()(text& t) const { order += std::move(t.value); }
+        void operator()(double d) const { order += std::to_string(static_cast<int>(d * 2)); }
+    };
+    REQUIRE(ch.drain(visitor { order }, 2) == 2);
+    REQUIRE(order == "t1hello");
+    REQUIRE(ch.drain(visitor { order }) == 2);
+    REQUIRE(order == "t1hello5t2");
+    REQUIRE(ch.drain(visitor { order }) == 0);
+
+    // The ring wraps around once the consumer frees its slots
+    for(int i = 0; i < 10; ++i) {
+        REQUIRE(ch.try_push(tick { 0, i }));
+        REQUIRE(ch.drain([](auto& /* msg */) { }) == 1);
+    }
+}
+
+TEST_CASE("channel destroys undrained messages", "[channel]") {
+    const auto counter = std::make_shared<int>(0);
+    {
+        kt::channel<kt::type_list_t<std::shared_ptr<int>, int>> ch(4);
+        ch.push(counter);
+        ch.push(counter);
+        REQUIRE(counter.use_count() == 3);
+        ch.drain([](auto& /* msg */) { }, 1);
+        REQUIRE(counter.use_count() == 2);
+    }
+    REQUIRE(counter.use_count() == 1);
+}
+
+TEST_CASE("channel skips slots whose message failed to construct", "[channel]") {
+    kt::channel<kt::type_list_t<fragile, int>> ch(4);
+    const fragile bad(-1);
+    REQUIRE_THROWS_AS(ch.try_push(bad), std::runtime_error);
+    REQUIRE(ch.try_push(fragile(1)));
+    REQUIRE_THROWS_AS(ch.try_push(bad), std::runtime_error);
+    REQUIRE(ch.try_push(2));
+
+    std::vector<int> values;
+    const auto collect = [&values](auto& msg) {
+        if constexpr(std::is_same_v<std::decay_t<decltype(msg)>, fragile>) {
+            values.push_back(msg.value);
+        }
+        else {
+            values.push_back(msg);
+        }
+    };
+    REQUIRE(ch.drain(collect, 1) == 1);
+    REQUIRE(values == std::vector<int> { 1 });
+    REQUIRE(ch.drain(collect) == 1);
+    REQUIRE(values == std::vector<int> { 1, 2 });
+    REQUIRE(ch.drain(collect) == 0);
+}
+
+TEST_CASE("channel accepts messages from multiple producers", "[channel]") {
+    constexpr int producers    = 4;
+    constexpr int per_producer = 20000;
+    kt::channel<messages> ch(64);
+
+    std::vector<std::thread> threads;
+    for(int p = 0; p < producers; ++p) {
+        threads.emplace_back([&ch, p] {
+            for(int i = 0; i < per_producer; ++i) {
+                ch.push(tick { p, i });
+            }
+        });
+    }
+
+    std::vector<int> next(producers, 0);
+    bool ordered  = true;
+    int received  = 0;
+    while(received < producers * per_producer) {
+        received += static_cast<int>(ch.drain([&](auto& msg) {
+            if constexpr(std::is_same_v<kt::remove_cvref_t<decltype(msg)>, tick>) {
+                ordered = ordered && msg.seq == next[msg.producer];
+                ++next[msg.producer];
+            }
+        }));
+    }
+    for(auto& t : threads) {
+        t.join();
+    }
+    REQUIRE(ordered);
+    REQUIRE(next == std::vector<int>(producers, per_producer));
+}
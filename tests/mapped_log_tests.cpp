@@ -0,0 +1,301 @@
+/*
+MIT License
+
+Copyright (c) 2023 Kieran Hsieh
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+#include <kt/mapped_log.hpp>
+#include <catch2/catch_test_macros.hpp>
+
+#include <cstdint>
+#include <cstdio>
+#include <iterator>
+#include <stdexcept>
+#include <string>
+
+#include <signal.h>
+#include <sys/resource.h>
+
+namespace kt_mapped_log_test {
+    struct order { };
+
+    template<typename T>
+    struct wrapper { };
+}
+
+namespace {
+    struct trade {
+        std::uint64_t id;
+        double price;
+        std::uint32_t qty;
+    };
+
+    struct quote {
+        double bid;
+        double ask;
+    };
+
+    using records = kt::type_list_t<trade, quote, std::uint8_t>;
+
+    struct temp_file {
+        std::string path = "kt_mapped_log_test_" + std::to_string(::getpid()) + ".log";
+        ~temp_file() { std::remove(path.c_str()); }
+    };
+
+    struct collector {
+        std::string& order;
+        double& total;
+        void operator()(const trade& t) const {
+            order += 't';
+            total += t.price * t.qty;
+        }
+        void operator()(const quote& q) const {
+            order += 'q';
+            total += q.ask - q.bid;
+        }
+        void operator()(std::uint8_t b) const {
+            order += 'b';
+            total += b;
+        }
+    };
+}
+
+TEST_CASE("mapped_log reads back appended records in order", "[mapped_log]") {
+    const temp_file file;
+    {
+        kt::mapped_log<records> log(file.path, kt::log_mode::truncate);
+        REQUIRE(log.empty());
+        log.append(trade { 1, 2.0, 3 });
+        log.append(quote { 1.0, 1.5 });
+        log.append(std::uint8_t { 4 });
+        REQUIRE(!log.empty());
+
+        std::string order;
+        double total = 0;
+        log.for_each(collector { order, total });
+        REQUIRE(order == "tqb");
+        REQUIRE(total == 10.5);
+    }
+
+    kt::mapped_log<records> log(file.path, kt::log_mode::read);
+    size_t count = 0;
+    for(const auto& rec : log) {
+        REQUIRE(rec.index() == count);
+        REQUIRE(reinterpret_cast<std::uintptr_t>(rec.data()) % alignof(trade) == 0);
+        ++count;
+    }
+    REQUIRE(count == 3);
+    REQUIRE(log.begin()->visit([](const auto& value) { return sizeof(value); }) == sizeof(trade));
+    REQUIRE_THROWS_AS(log.append(quote { 0.0, 1.0 }), std::logic_error);
+    REQUIRE(std::distance(log.begin(), log.end()) == 3);
+}
+
+TEST_CASE("mapped_log grows in chunks and appends to existing files", "[mapped_log]") {
+    const temp_file file;
+    constexpr size_t chunk = 4096;
+    {
+        kt::mapped_log<records> log(file.path, kt::log_mode::truncate, chunk);
+        for(std::uint64_t i = 0; i < 1000; ++i) {
+            log.append(trade { i, 1.0, 1 });
+        }
+        REQUIRE(log.capacity() > chunk);
+        REQUIRE(log.capacity() % chunk == 0);
+        log.flush();
+    }
+    {
+        kt::mapped_log<records> log(file.path, kt::log_mode::append, chunk);
+        log.append(quote { 0.0, 2.0 });
+    }
+
+    kt::mapped_log<records> log(file.path, kt::log_mode::read);
+    std::string order;
+    double total = 0;
+    log.for_each(collector { order, total });
+    REQUIRE(order == std::string(1000, 't') + "q");
+    REQUIRE(total == 1002.0);
+}
+
+TEST_CASE("mapped_log rejects files written with a different type list", "[mapped_log]") {
+    const temp_file file;
+    {
+        kt::mapped_log<records> log(file.path, kt::log_mode::truncate);
+        log.append(quote { 1.0, 2.0 });
+    }
+    using reordered = kt::mapped_log<kt::type_list_t<quote, trade, std::uint8_t>>;
+    using retyped   = kt::mapped_log<kt::type_list_t<trade, quote, std::int8_t>>;
+    REQUIRE(kt::mapped_log<records>::fingerprint != reordered::fingerprint);
+    REQUIRE(kt::mapped_log<records>::fingerprint != retyped::fingerprint);
+    REQUIRE_THROWS_AS(reordered(file.path, kt::log_mode::read), std::runtime_error);
+    REQUIRE_THROWS_AS(retyped(file.path, kt::log_mode::append), std::runtime_error);
+    REQUIRE_THROWS_AS(kt::mapped_log<records>(file.path + ".missing", kt::log_mode::read), std::system_error);
+}
+
+TEST_CASE("mapped_log fingerprints only the type names", "[mapped_log]") {
+    REQUIRE(kt::detail::mapped_log_type_name<kt_mapped_log_test::order>() == "kt_mapped_log_test::order");
+    REQUIRE(kt::detail::mapped_log_type_name<kt_mapped_log_test::wrapper<kt_mapped_log_test::order>>() ==
+            "kt_mapped_log_test::wrapper<kt_mapped_log_test::order>");
+
+    // Arithmetic types are described by kind and size, which compilers agree on. std::uint64_t is unsigned long on LP64 targets
+    // and unsigned long long on ILP32 ones, so each is only compared with it when their sizes match.
+    if constexpr(sizeof(unsigned long long) == sizeof(std::uint64_t)) {
+        REQUIRE(kt::mapped_log<kt::type_list_t<unsigned long long>>::fingerprint ==
+                kt::mapped_log<kt::type_list_t<std::uint64_t>>::fingerprint);
+    }
+    if constexpr(sizeof(unsigned long) == sizeof(std::uint64_t)) {
+        REQUIRE(kt::mapped_log<kt::type_list_t<unsigned long>>::fingerprint == kt::mapped_log<kt::type_list_t<std::uint64_t>>::fingerprint);
+    }
+    REQUIRE(kt::mapped_log<kt::type_list_t<long>>::fingerprint != kt::mapped_log<kt::type_list_t<unsigned long>>::fingerprint);
+    REQUIRE(kt::mapped_log<kt::type_list_t<bool>>::fingerprint != kt::mapped_log<kt::type_list_t<std::uint8_t>>::fingerprint);
+}
+
+TEST_CASE("mapped_log leaves files which are not logs untouched", "[mapped_log]") {
+    const temp_file file;
+    const std::string contents(100, 'x');
+    std::FILE* out = std::fopen(file.path.c_str(), "wb");
+    std::fwrite(contents.data(), 1, contents.size(), out);
+    std::fclose(out);
+
+    REQUIRE_THROWS_AS(kt::mapped_log<records>(file.path, kt::log_mode::append), std::runtime_error);
+
+    std::string read_back(200, '\0');
+    std::FILE* in = std::fopen(file.path.c_str(), "rb");
+    read_back.resize(std::fread(&read_back[0], 1, read_back.size(), in));
+    std::fclose(in);
+    REQUIRE(read_back == contents);
+}
+
+TEST_CASE("mapped_log throws on corrupt record headers", "[mapped_log]") {
+    const temp_file file;
+    const auto write_log = [&] {
+        kt::mapped_log<records> log(file.path, kt::log_mode::truncate);
+        log.append(trade { 1, 2.0, 3 });
+        log.append(quote { 1.0, 1.5 });
+    };
+    const auto corrupt = [&](long offset, std::uint64_t value, size_t bytes) {
+        std::FILE* out = std::fopen(file.path.c_str(), "r+b");
+        std::fseek(out, offset, SEEK_SET);
+        std::fwrite(&value, bytes, 1, out);
+        std::fclose(out);
+    };
+    const auto replay = [&] {
+        const kt::mapped_log<records> log(file.path, kt::log_mode::read);
+        std::string order;
+        double total = 0;
+        log.for_each(collector { order, total });
+    };
+    // The file header holds the end of the record data at byte 16. The first record header follows it at byte 32, holding the
+    // record's type index and then its size.
+    constexpr long data_end_offset = 16;
+    constexpr long type_offset     = 32;
+    constexpr long size_offset     = 36;
+
+    write_log();
+    corrupt(type_offset, 0x40000000, sizeof(std::uint32_t));
+    REQUIRE_THROWS_AS(replay(), std::runtime_error);
+    REQUIRE_THROWS_AS(++kt::mapped_log<records>(file.path, kt::log_mode::read).begin(), std::runtime_error);
+
+    write_log();
+    corrupt(size_offset, sizeof(quote), sizeof(std::uint32_t));
+    REQUIRE_THROWS_AS(replay(), std::runtime_error);
+
+    write_log();
+    const size_t end = kt::mapped_log<records>(file.path, kt::log_mode::read).bytes() + 32;
+    corrupt(data_end_offset, end - 8, sizeof(std::uint64_t));
+    REQUIRE_THROWS_AS(replay(), std::runtime_error);
+
+    // An end which stops partway into the second record's header
+    write_log();
+    corrupt(data_end_offset, 64 + sizeof(std::uint32_t), sizeof(std::uint64_t));
+    REQUIRE_THROWS_AS(replay(), std::runtime_error);
+
+    write_log();
+    REQUIRE_NOTHROW(replay());
+}
+
+TEST_CASE("mapped_log readers see a consistent log while another log appends", "[mapped_log]") {
+    const temp_file file;
+    constexpr size_t chunk = 4096;
+    using numbers          = kt::mapped_log<kt::type_list_t<std::uint64_t>>;
+
+    numbers writer(file.path, kt::log_mode::truncate, chunk);
+    writer.append(std::uint64_t { 0 });
+    numbers reader(file.path, kt::log_mode::read);
+    const size_t mapped = reader.capacity();
+
+    for(std::uint64_t i = 1; i < 100000; ++i) {
+        writer.append(i);
+    }
+    REQUIRE(writer.capacity() > mapped);
+
+    std::uint64_t count = 0;
+    reader.for_each([&](std::uint64_t value) { REQUIRE(value == count++); });
+    REQUIRE(count == 1);
+
+    reader.refresh();
+    REQUIRE(reader.capacity() >= writer.bytes());
+    count = 0;
+    reader.for_each([&](std::uint64_t value) { REQUIRE(value == count++); });
+    REQUIRE(count == 100000);
+    REQUIRE(reader.bytes() == writer.bytes());
+}
+
+TEST_CASE("mapped_log stays usable when the file cannot grow", "[mapped_log]") {
+    const temp_file file;
+    constexpr size_t chunk = 4096;
+
+    // Exceeding RLIMIT_FSIZE makes ftruncate fail with EFBIG instead of raising SIGXFSZ while the signal is ignored
+    struct rlimit old_limit { };
+    ::getrlimit(RLIMIT_FSIZE, &old_limit);
+    struct sigaction ignore { };
+    struct sigaction old_action { };
+    ignore.sa_handler = SIG_IGN;
+    ::sigaction(SIGXFSZ, &ignore, &old_action);
+    struct rlimit limit = old_limit;
+    limit.rlim_cur      = 2 * chunk;
+    ::setrlimit(RLIMIT_FSIZE, &limit);
+
+    std::string order;
+    double total    = 0;
+    size_t appended = 0;
+    {
+        kt::mapped_log<records> log(file.path, kt::log_mode::truncate, chunk);
+        try {
+            for(; appended < 1000; ++appended) {
+                log.append(quote { 0.0, 1.0 });
+            }
+        }
+        catch(const std::system_error&) {
+        }
+        ::setrlimit(RLIMIT_FSIZE, &old_limit);
+        ::sigaction(SIGXFSZ, &old_action, nullptr);
+
+        REQUIRE(appended < 1000);
+        REQUIRE(log.capacity() == 2 * chunk);
+        log.for_each(collector { order, total });
+        REQUIRE(order == std::string(appended, 'q'));
+
+        log.append(std::uint8_t { 1 });
+    }
+
+    const kt::mapped_log<records> log(file.path, kt::log_mode::read);
+    order.clear();
+    log.for_each(collector { order, total });
+    REQUIRE(order == std::string(appended, 'q') + "b");
+}
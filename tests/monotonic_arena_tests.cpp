@@ -0,0 +1,123 @@
+/*
+MIT License
+
+Copyright (c) 2023 Kieran Hsieh
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+#include <kt/monotonic_arena.hpp>
+#include <catch2/catch_test_macros.hpp>
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace {
+    struct point {
+        double x;
+        double y;
+    };
+
+    struct alignas(32) wide {
+        unsigned char bytes[64];
+    };
+
+    struct tracked {
+        explicit tracked(std::vector<int>& destroyed_log, int tracked_id) : log(destroyed_log), id(tracked_id) { }
+        ~tracked() { log.push_back(id); }
+
+        std::vector<int>& log;
+        int id;
+    };
+
+    struct small_tracked {
+        explicit small_tracked(int& destroyed_count) : destroyed(&destroyed_count) { }
+        ~small_tracked() { ++*destroyed; }
+
+        int* destroyed;
+    };
+
+    struct flag {
+        ~flag() { }
+
+        char value = 0;
+    };
+}
+
+TEST_CASE("monotonic_arena constructs aligned objects", "[monotonic_arena]") {
+    kt::monotonic_arena<kt::type_list_t<char, point, wide>> arena(4);
+    const char* c  = arena.make<char>('a');
+    const point* p = arena.make<point>(point { 1.0, 2.0 });
+    const wide* w  = arena.make<wide>();
+    REQUIRE(*c == 'a');
+    REQUIRE(p->y == 2.0);
+    REQUIRE(reinterpret_cast<std::uintptr_t>(p) % alignof(point) == 0);
+    REQUIRE(reinterpret_cast<std::uintptr_t>(w) % alignof(wide) == 0);
+    REQUIRE(arena.block_count() == 1);
+}
+
+TEST_CASE("monotonic_arena grows by whole blocks and reuses them after release", "[monotonic_arena]") {
+    kt::monotonic_arena<kt::type_list_t<std::uint64_t, point>> arena(8);
+    for(int i = 0; i < 8; ++i) {
+        arena.make<point>();
+    }
+    REQUIRE(arena.block_count() == 1);
+    arena.make<point>();
+    REQUIRE(arena.block_count() == 2);
+
+    arena.release();
+    for(int i = 0; i < 16; ++i) {
+        arena.make<point>();
+    }
+    REQUIRE(arena.block_count() == 2);
+}
+
+TEST_CASE("monotonic_arena destroys non-trivial objects in reverse order", "[monotonic_arena]") {
+    std::vector<int> log;
+    {
+        kt::monotonic_arena<kt::type_list_t<tracked, std::string, int>> arena(1);
+        arena.make<tracked>(log, 1);
+        REQUIRE(*arena.make<std::string>(100, 'x') == std::string(100, 'x'));
+        arena.make<int>(5);
+        arena.make<tracked>(log, 2);
+        arena.release();
+        REQUIRE(log == std::vector<int> { 2, 1 });
+
+        arena.make<tracked>(log, 3);
+    }
+    REQUIRE(log == std::vector<int> { 2, 1, 3 });
+}
+
+TEST_CASE("monotonic_arena fits the requested number of small non-trivial objects in a block", "[monotonic_arena]") {
+    kt::monotonic_arena<kt::type_list_t<flag>> flags(4);
+    for(int i = 0; i < 4; ++i) {
+        flags.make<flag>();
+    }
+    REQUIRE(flags.block_count() == 1);
+
+    int destroyed = 0;
+    {
+        kt::monotonic_arena<kt::type_list_t<char, small_tracked>> arena(3);
+        for(int i = 0; i < 3; ++i) {
+            arena.make<small_tracked>(destroyed);
+        }
+        REQUIRE(arena.block_count() == 1);
+    }
+    REQUIRE(destroyed == 3);
+}
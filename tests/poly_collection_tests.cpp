@@ -0,0 +1,100 @@
+/*
+MIT License
+
+Copyright (c) 2023 Kieran Hsieh
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+#include <kt/poly_collection.hpp>
+#include <catch2/catch_test_macros.hpp>
+
+#include <string>
+
+namespace {
+    struct circle {
+        double radius;
+    };
+
+    struct square {
+        double side;
+    };
+}
+
+TEST_CASE("poly_collection routes inserted elements to their buckets", "[poly_collection]") {
+    kt::poly_collection<kt::type_list_t<circle, square, std::string>> pc;
+    REQUIRE(pc.empty());
+
+    pc.insert(circle { 1.0 });
+    pc.insert(square { 2.0 });
+    const std::string name = "shape";
+    pc.insert(name);
+    pc.emplace(kt::tag<circle>, circle { 3.0 });
+
+    REQUIRE(pc.size() == 4);
+    REQUIRE(pc.size(kt::tag<circle>) == 2);
+    REQUIRE(pc.size(kt::tag<square>) == 1);
+    REQUIRE(pc.bucket(kt::tag<circle>)[1].radius == 3.0);
+    REQUIRE(pc.bucket(kt::tag<std::string>).front() == "shape");
+}
+
+TEST_CASE("poly_collection visits elements bucket by bucket", "[poly_collection]") {
+    kt::poly_collection<kt::type_list_t<square, circle>> pc;
+    pc.insert(circle { 1.0 });
+    pc.insert(square { 2.0 });
+    pc.insert(circle { 3.0 });
+
+    std::string order;
+    double total = 0;
+    struct visitor {
+        std::string& order;
+        double& total;
+        void operator()(const circle& c) const {
+            order += 'c';
+            total += c.radius;
+        }
+        void operator()(const square& s) const {
+            order += 's';
+            total += s.side;
+        }
+    };
+    pc.for_each(visitor { order, total });
+    REQUIRE(order == "scc");
+    REQUIRE(total == 6.0);
+
+    pc.for_each([](auto& elem) { elem = { }; });
+    const auto& cpc = pc;
+    total           = 0;
+    cpc.for_each(visitor { order, total });
+    REQUIRE(total == 0.0);
+}
+
+TEST_CASE("poly_collection supports batch insertion and reservation", "[poly_collection]") {
+    kt::poly_collection<kt::type_list_t<int, double>> pc;
+    pc.reserve(kt::tag<double>, 16);
+    REQUIRE(pc.bucket(kt::tag<double>).capacity() >= 16);
+
+    const std::vector<double> values { 1.0, 2.0, 3.0 };
+    pc.insert_range(values.begin(), values.end());
+    REQUIRE(pc.bucket(kt::tag<double>) == values);
+    REQUIRE(pc.size(kt::tag<int>) == 0);
+
+    pc.clear();
+    REQUIRE(pc.empty());
+    REQUIRE(pc.bucket(kt::tag<double>).capacity() >= 16);
+}
@@ -0,0 +1,229 @@
+/*
+MIT License
+
+Copyright (c) 2023 Kieran Hsieh
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+#include <kt/serializer.hpp>
+#include <catch2/catch_test_macros.hpp>
+
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <tuple>
+#include <type_traits>
+#include <vector>
+
+namespace kt_serializer_test {
+    // A packed record with tail padding, so it cannot be copied whole but its fields form one run
+    struct header {
+        std::uint32_t id;
+        std::uint16_t flags;
+    };
+
+    template<size_t I>
+    auto& get(header& h) {
+        if constexpr(I == 0) {
+            return h.id;
+        }
+        else {
+            return h.flags;
+        }
+    }
+
+    template<size_t I>
+    const auto& get(const header& h) {
+        return get<I>(const_cast<header&>(h));
+    }
+}
+
+namespace std {
+    template<>
+    struct tuple_size<kt_serializer_test::header> : integral_constant<size_t, 2> { };
+
+    template<>
+    struct tuple_element<0, kt_serializer_test::header> {
+        using type = uint32_t;
+    };
+
+    template<>
+    struct tuple_element<1, kt_serializer_test::header> {
+        using type = uint16_t;
+    };
+}
+
+namespace kt {
+    template<>
+    struct is_packed_record<kt_serializer_test::header> : std::true_type { };
+}
+
+namespace {
+    // Trivially copyable, but without a default constructor
+    struct price {
+        explicit price(double v) : value(v) { }
+
+        double value;
+    };
+
+    enum class side : std::uint16_t {
+        buy  = 1,
+        sell = 0x0102
+    };
+
+    using fields = kt::type_list_t<std::uint32_t, std::uint8_t, side, double>;
+    using codec  = kt::serializer<fields>;
+}
+
+TEST_CASE("serializer computes a packed wire layout", "[serializer]") {
+    REQUIRE(codec::wire_size == 4 + 1 + 2 + 8);
+    REQUIRE(codec::offset(kt::index<0>) == 0);
+    REQUIRE(codec::offset(kt::index<1>) == 4);
+    REQUIRE(codec::offset(kt::index<2>) == 5);
+    REQUIRE(codec::offset(kt::index<3>) == 7);
+    REQUIRE(kt::serializer<kt::type_list_t<>>::wire_size == 0);
+
+    std::tuple<> empty;
+    unsigned char byte = 0;
+    kt::serializer<kt::type_list_t<>>::encode(empty, &byte);
+    kt::serializer<kt::type_list_t<>>::decode(&byte, empty);
+    REQUIRE(byte == 0);
+}
+
+TEST_CASE("serializer encodes fields little-endian", "[serializer]") {
+    unsigned char bytes[codec::wire_size] = { };
+    codec::encode(codec::record_type { 0x01020304U, 0xAA, side::sell, 1.0 }, bytes);
+    REQUIRE(bytes[0] == 0x04);
+    REQUIRE(bytes[3] == 0x01);
+    REQUIRE(bytes[4] == 0xAA);
+    REQUIRE(bytes[5] == 0x02);
+    REQUIRE(bytes[6] == 0x01);
+    REQUIRE(bytes[14] == 0x3F);
+}
+
+TEST_CASE("serializer round-trips records", "[serializer]") {
+    const codec::record_type record { 7, 3, side::buy, 2.5 };
+    unsigned char bytes[codec::wire_size];
+    codec::encode(record, bytes);
+    REQUIRE(codec::decode(bytes) == record);
+
+    using words = kt::serializer<kt::type_list_t<std::uint16_t, std::uint16_t, std::uint16_t>>;
+    const std::array<std::uint16_t, 3> arr { 1, 0x0203, 4 };
+    unsigned char arr_bytes[words::wire_size];
+    words::encode(arr, arr_bytes);
+    REQUIRE(arr_bytes[2] == 0x03);
+    std::array<std::uint16_t, 3> decoded { };
+    words::decode(arr_bytes, decoded);
+    REQUIRE(decoded == arr);
+}
+
+TEST_CASE("serializer encodes and decodes batches", "[serializer]") {
+    std::vector<codec::record_type> records;
+    for(std::uint32_t i = 0; i < 10; ++i) {
+        records.emplace_back(i, static_cast<std::uint8_t>(i * 2), i % 2 == 0 ? side::buy : side::sell, i * 0.5);
+    }
+    std::vector<unsigned char> bytes(records.size() * codec::wire_size);
+    codec::encode_batch(records.data(), records.size(), bytes.data());
+
+    std::vector<codec::record_type> decoded(records.size());
+    codec::decode_batch(bytes.data(), decoded.size(), decoded.data());
+    REQUIRE(decoded == records);
+
+    kt::view<fields> v(bytes.data());
+    v = v.next().next();
+    REQUIRE(v.get(kt::index<0>) == 2);
+    REQUIRE(v.get(kt::index<1>) == 4);
+    REQUIRE(v.get(kt::index<2>) == side::buy);
+    REQUIRE(v.get(kt::index<3>) == 1.0);
+    REQUIRE(v.data() == bytes.data() + 2 * codec::wire_size);
+}
+
+TEST_CASE("serializer copies packed records", "[serializer]") {
+    using header_codec = kt::serializer<kt::type_list_t<std::uint32_t, std::uint16_t>>;
+    const std::vector<kt_serializer_test::header> headers { { 0x01020304U, 0x0506 }, { 7, 8 } };
+    std::vector<unsigned char> bytes(headers.size() * header_codec::wire_size);
+    header_codec::encode_batch(headers.data(), headers.size(), bytes.data());
+
+    unsigned char expected[header_codec::wire_size];
+    header_codec::encode(std::tuple<std::uint32_t, std::uint16_t>(0x01020304U, 0x0506), expected);
+    REQUIRE(std::equal(expected, expected + header_codec::wire_size, bytes.begin()));
+
+    std::vector<kt_serializer_test::header> decoded(headers.size());
+    header_codec::decode_batch(bytes.data(), decoded.size(), decoded.data());
+    REQUIRE(decoded[0].id == 0x01020304U);
+    REQUIRE(decoded[0].flags == 0x0506);
+    REQUIRE(decoded[1].id == 7);
+    REQUIRE(decoded[1].flags == 8);
+
+    using row_codec = kt::serializer<kt::type_list_t<std::uint64_t, std::uint64_t>>;
+    const std::vector<std::array<std::uint64_t, 2>> rows { { 1, 2 }, { 3, 4 }, { 5, 6 } };
+    std::vector<unsigned char> row_bytes(rows.size() * row_codec::wire_size);
+    row_codec::encode_batch(rows.data(), rows.size(), row_bytes.data());
+    REQUIRE(kt::view<kt::type_list_t<std::uint64_t, std::uint64_t>>(row_bytes.data()).next().next().get(kt::index<1>) == 6);
+
+    std::vector<std::array<std::uint64_t, 2>> decoded_rows(rows.size());
+    row_codec::decode_batch(row_bytes.data(), decoded_rows.size(), decoded_rows.data());
+    REQUIRE(decoded_rows == rows);
+}
+
+TEST_CASE("serializer copies field_records by runs", "[serializer]") {
+    static_assert(std::is_same_v<codec::record_type, kt::field_record<std::uint32_t, std::uint8_t, side, double>>);
+    REQUIRE(codec::record_type::offset(kt::index<0>) == 0);
+    REQUIRE(codec::record_type::offset(kt::index<1>) == 4);
+    REQUIRE(codec::record_type::offset(kt::index<2>) == 6);
+    REQUIRE(codec::record_type::offset(kt::index<3>) == 8);
+
+    codec::record_type record { 0x01020304U, 0xAA, side::sell, 1.5 };
+    auto& [id, flags, s, value] = record;
+    REQUIRE(id == 0x01020304U);
+    REQUIRE(flags == 0xAA);
+    REQUIRE(s == side::sell);
+    REQUIRE(value == 1.5);
+    kt::get<3>(record) = 2.5;
+    REQUIRE(value == 2.5);
+
+    // The padding after the second field splits the record into two runs, which must encode like separate fields
+    unsigned char bytes[codec::wire_size];
+    unsigned char expected[codec::wire_size];
+    codec::encode(record, bytes);
+    codec::encode(std::tuple<std::uint32_t, std::uint8_t, side, double>(0x01020304U, 0xAA, side::sell, 2.5), expected);
+    REQUIRE(std::equal(bytes, bytes + codec::wire_size, expected));
+
+    // Without padding, records and batches are copied whole
+    using words = kt::serializer<kt::type_list_t<std::uint32_t, std::uint32_t, std::uint64_t>>;
+    REQUIRE(sizeof(words::record_type) == words::wire_size);
+    const std::vector<words::record_type> rows { { 1, 2, 3 }, { 4, 5, 6 } };
+    std::vector<unsigned char> row_bytes(rows.size() * words::wire_size);
+    words::encode_batch(rows.data(), rows.size(), row_bytes.data());
+    REQUIRE(kt::view<kt::type_list_t<std::uint32_t, std::uint32_t, std::uint64_t>>(row_bytes.data()).next().get(kt::index<2>) == 6);
+    std::vector<words::record_type> decoded(rows.size());
+    words::decode_batch(row_bytes.data(), decoded.size(), decoded.data());
+    REQUIRE(decoded == rows);
+}
+
+TEST_CASE("serializer decodes fields which are not default constructible", "[serializer]") {
+    using priced = kt::serializer<kt::type_list_t<std::uint16_t, price>>;
+    unsigned char bytes[priced::wire_size];
+    priced::encode(priced::record_type { 3, price { 4.5 } }, bytes);
+
+    const priced::record_type record = priced::decode(bytes);
+    REQUIRE(kt::get<0>(record) == 3);
+    REQUIRE(kt::get<1>(record).value == 4.5);
+    REQUIRE(kt::view<kt::type_list_t<std::uint16_t, price>>(bytes).get(kt::index<1>).value == 4.5);
+}
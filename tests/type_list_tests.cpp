@@ -24,6 +24,9 @@ SOFTWARE.
 #include <kt/type_list.hpp>
 #include <catch2/catch_test_macros.hpp>
 
+#include <memory>
+#include <utility>
+
 TEST_CASE("type_list reports correct size", "[access]") {
     REQUIRE(kt::type_list<>.size() == 0);    // NOLINT
     REQUIRE(kt::type_list<int>.size() == 1);
@@ -76,6 +79,69 @@ TEST_CASE("type_list can do conjunction and disjunction operations", "[access]")
     REQUIRE(kt::type_list<const int, int>.one_of(kt::func<std::is_const>));
 }
 
+namespace {
+    // Fails to compile if instantiated with void, so a test using it only compiles if evaluation stops before void is reached
+    template<typename T>
+    struct is_const_checked : std::is_const<T> {
+        static_assert(!std::is_void_v<T>, "Evaluation did not short-circuit");
+    };
+
+    template<size_t I>
+    struct generated {
+        static constexpr size_t value = I;
+    };
+
+    template<size_t... IS>
+    constexpr auto make_generated_list(std::index_sequence<IS...> /* indices */) {
+        return kt::type_list<generated<IS>...>;
+    }
+
+    // Both fail to compile if instantiated with void, as void has no value member
+    template<typename T>
+    struct is_generated_1100 : std::bool_constant<T::value == 1100> { };
+
+    template<typename T>
+    struct is_generated_before_1100 : std::bool_constant<(T::value < 1100)> { };
+}
+
+TEST_CASE("type_list can do short-circuiting queries", "[access]") {
+    REQUIRE(kt::type_list<>.all_of_lazy(kt::func<std::is_const>));
+    REQUIRE(kt::type_list<const int, const double>.all_of_lazy(kt::func<std::is_const>));
+    REQUIRE(!kt::type_list<int, void>.all_of_lazy(kt::func<is_const_checked>));
+
+    REQUIRE(!kt::type_list<>.any_of(kt::func<std::is_const>));
+    REQUIRE(!kt::type_list<int, double>.any_of(kt::func<std::is_const>));
+    REQUIRE(kt::type_list<const int, void>.any_of(kt::func<is_const_checked>));
+
+    REQUIRE(kt::type_list<>.none_of(kt::func<std::is_const>));
+    REQUIRE(kt::type_list<int, double>.none_of(kt::func<std::is_const>));
+    REQUIRE(!kt::type_list<const int, void>.none_of(kt::func<is_const_checked>));
+
+    REQUIRE(kt::type_list<>.count_if(kt::func<std::is_const>) == 0);
+    REQUIRE(kt::type_list<const int, double, const float>.count_if(kt::func<std::is_const>) == 2);
+
+    REQUIRE(kt::type_list<>.find_if(kt::func<std::is_const>) == kt::npos);
+    REQUIRE(kt::type_list<int, double>.find_if(kt::func<std::is_const>) == kt::npos);
+    REQUIRE(kt::type_list<int, const double, const float>.find_if(kt::func<std::is_const>) == 1);
+    REQUIRE(kt::type_list<int, const double, void>.find_if(kt::func<is_const_checked>) == 1);
+}
+
+TEST_CASE("type_list can do short-circuiting queries on long type lists", "[access]") {
+    constexpr auto generated_list = make_generated_list(std::make_index_sequence<1200>());
+    constexpr auto guarded_list   = generated_list.append(kt::tag<void>);
+
+    REQUIRE(!generated_list.all_of_lazy(kt::func<is_generated_before_1100>));
+    REQUIRE(!guarded_list.all_of_lazy(kt::func<is_generated_before_1100>));
+    REQUIRE(make_generated_list(std::make_index_sequence<1100>()).all_of_lazy(kt::func<is_generated_before_1100>));
+
+    REQUIRE(guarded_list.any_of(kt::func<is_generated_1100>));
+    REQUIRE(!guarded_list.none_of(kt::func<is_generated_1100>));
+    REQUIRE(!make_generated_list(std::make_index_sequence<1100>()).any_of(kt::func<is_generated_1100>));
+
+    REQUIRE(guarded_list.find_if(kt::func<is_generated_1100>) == 1100);
+    REQUIRE(make_generated_list(std::make_index_sequence<1100>()).find_if(kt::func<is_generated_1100>) == kt::npos);
+}
+
 TEST_CASE("type_list can access a given index", "[access]") {
     REQUIRE(std::is_same_v<kt::from_tag_t<decltype(kt::type_list<int, double, short>.at(kt::index<0>))>, int>);
     REQUIRE(std::is_same_v<kt::from_tag_t<decltype(kt::type_list<int, double, short>.at(kt::index<1>))>, double>);
@@ -151,4 +217,59 @@ TEST_CASE("type_list can pop front and back elements", "[modifiers]") {
     REQUIRE(kt::type_list<>.pop_front() == kt::type_list<>);
     REQUIRE(kt::type_list<int>.pop_front() == kt::type_list<>);
     REQUIRE(kt::type_list<int, float>.pop_front() == kt::type_list<float>);
-}
\ No newline at end of file
+}
+
+TEST_CASE("type_list can report its layout", "[layout]") {
+    struct big {
+        double values[4];
+    };
+
+    constexpr auto empty = kt::type_list<>.layout();
+    REQUIRE(empty.max_size == 0);
+    REQUIRE(empty.max_align == 1);
+    REQUIRE(empty.packed_size == 0);
+    REQUIRE(empty.trivially_destructible);
+
+    constexpr auto layout = kt::type_list<char, big, int>.layout();
+    REQUIRE(layout.max_size == sizeof(big));
+    REQUIRE(layout.max_align == alignof(double));
+    REQUIRE(layout.packed_size == sizeof(char) + sizeof(big) + sizeof(int));
+    REQUIRE(layout.offsets == std::array<size_t, 3> { 0, sizeof(char), sizeof(char) + sizeof(big) });
+    REQUIRE(layout.trivially_destructible);
+    REQUIRE(layout.trivially_copyable);
+
+    REQUIRE(!kt::type_list<int, std::unique_ptr<int>>.layout().trivially_destructible);
+    REQUIRE(!kt::type_list<int, std::unique_ptr<int>>.layout().trivially_copyable);
+}
+
+namespace {
+    template<typename I, typename T>
+    struct index_array {
+        using type = T[I::value + 1];
+    };
+
+    template<typename I, typename T>
+    struct is_even_index : std::bool_constant<I::value % 2 == 0> { };
+
+    template<typename A, typename B>
+    struct larger {
+        using type = std::conditional_t<(sizeof(B) > sizeof(A)), B, A>;
+    };
+}
+
+TEST_CASE("type_list can apply and filter using indexed metafunctions", "[modifiers]") {
+    REQUIRE(kt::type_list<>.apply_indexed(kt::func_i<index_array>) == kt::type_list<>);
+    REQUIRE(kt::type_list<int, double, char>.apply_indexed(kt::func_i<index_array>) == kt::type_list<int[1], double[2], char[3]>);
+
+    REQUIRE(kt::type_list<>.filter_indexed(kt::func_i<is_even_index>) == kt::type_list<>);
+    REQUIRE(kt::type_list<int, double, char, short>.filter_indexed(kt::func_i<is_even_index>) == kt::type_list<int, char>);
+}
+
+TEST_CASE("type_lists can be zipped", "[modifiers]") {
+    REQUIRE(kt::zip_with(kt::type_list<>, kt::type_list<>, kt::func2<larger>) == kt::type_list<>);
+    REQUIRE(kt::zip_with(kt::type_list<char, double>, kt::type_list<int, float>, kt::func2<larger>) == kt::type_list<int, double>);
+
+    REQUIRE(kt::zip(kt::type_list<>, kt::type_list<>) == kt::type_list<>);
+    REQUIRE(kt::zip(kt::type_list<int, double>, kt::type_list<char, short>) ==
+            kt::type_list<kt::type_list_t<int, char>, kt::type_list_t<double, short>>);
+}
@@ -0,0 +1,107 @@
+/*
+MIT License
+
+Copyright (c) 2023 Kieran Hsieh
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+#include <kt/value_list.hpp>
+#include <catch2/catch_test_macros.hpp>
+
+#include <functional>
+
+TEST_CASE("value_list reports size and emptiness", "[access]") {
+    REQUIRE(kt::value_list<>.size() == 0);    // NOLINT
+    REQUIRE(kt::value_list<1, 2>.size() == 2);
+    REQUIRE(kt::value_list<>.empty());
+    REQUIRE(!kt::value_list<1>.empty());
+}
+
+TEST_CASE("value_list can access elements", "[access]") {
+    REQUIRE(kt::value_list<3, 'a', 5u>.front() == 3);
+    REQUIRE(kt::value_list<3, 'a', 5u>.back() == 5u);
+    REQUIRE(kt::value_list<3, 'a', 5u>.at(kt::index<1>) == 'a');
+    REQUIRE(std::is_same_v<decltype(kt::value_list<3, 'a', 5u>.at(kt::index<1>)), char>);
+}
+
+TEST_CASE("value_list can look up values", "[access]") {
+    REQUIRE(kt::value_list<4, 8, 16>.index_of(kt::value<8>) == 1);
+    REQUIRE(kt::value_list<4, 8, 16>.index_of(kt::value<32>) == kt::npos);
+    REQUIRE(kt::value_list<4, 8, 16>.index_of(kt::value<8u>) == kt::npos);
+    REQUIRE(kt::value_list<4, 8, 4>.count_of(kt::value<4>) == 2);
+    REQUIRE(kt::value_list<4, 8>.contains(kt::value<8>));
+    REQUIRE(!kt::value_list<4, 8>.contains(kt::value<8L>));
+}
+
+TEST_CASE("value_list can do conjunction and disjunction operations", "[access]") {
+    constexpr auto positive = [](auto v) { return v > 0; };
+    REQUIRE(kt::value_list<>.all_of(positive));
+    REQUIRE(kt::value_list<1, 2>.all_of(positive));
+    REQUIRE(!kt::value_list<1, -2>.all_of(positive));
+    REQUIRE(!kt::value_list<>.one_of(positive));
+    REQUIRE(kt::value_list<-1, 2>.one_of(positive));
+}
+
+TEST_CASE("value_list can be compared with == and !=", "[equality]") {
+    REQUIRE(kt::value_list<1, 2> == kt::value_list<1, 2>);
+    REQUIRE(kt::value_list<1, 2> != kt::value_list<1, 3>);
+    REQUIRE(kt::value_list<1> != kt::value_list<1u>);
+    REQUIRE(kt::value_list<1> != kt::value_list<1, 1>);
+}
+
+TEST_CASE("value_list can append and prepend elements", "[modifiers]") {
+    REQUIRE(kt::value_list<1>.append(kt::value<2>) == kt::value_list<1, 2>);
+    REQUIRE(kt::value_list<1>.append(kt::value_list<2, 3>) == kt::value_list<1, 2, 3>);
+    REQUIRE(kt::value_list<1>.prepend(kt::value<2>) == kt::value_list<2, 1>);
+    REQUIRE(kt::value_list<1>.prepend(kt::value_list<2, 3>) == kt::value_list<2, 3, 1>);
+    REQUIRE(kt::value_list<> + kt::value<1> + kt::value_list<2> == kt::value_list<1, 2>);
+}
+
+TEST_CASE("value_list can apply and filter with constexpr callables", "[modifiers]") {
+    REQUIRE(kt::value_list<>.apply([](auto v) { return v * 2; }) == kt::value_list<>);
+    REQUIRE(kt::value_list<1, 2, 3>.apply([](auto v) { return v * 2; }) == kt::value_list<2, 4, 6>);
+    REQUIRE(kt::value_list<1, 2>.apply([](int v) { return v > 1; }) == kt::value_list<false, true>);
+    REQUIRE(kt::value_list<1, 2, 3, 4>.filter([](auto v) { return v % 2 == 0; }) == kt::value_list<2, 4>);
+    REQUIRE(kt::value_list<>.filter([](auto v) { return v % 2 == 0; }) == kt::value_list<>);
+}
+
+TEST_CASE("value_list can sort and remove duplicates", "[modifiers]") {
+    REQUIRE(kt::value_list<>.sort() == kt::value_list<>);
+    REQUIRE(kt::value_list<3, 1, 2>.sort() == kt::value_list<1, 2, 3>);
+    REQUIRE(kt::value_list<3, 1, 2>.sort(std::greater<>()) == kt::value_list<3, 2, 1>);
+    REQUIRE(kt::value_list<2, 'a', 1L>.sort() == kt::value_list<1L, 2, 'a'>);
+    REQUIRE(kt::value_list<1u, -1>.sort() == kt::value_list<-1, 1u>);
+    REQUIRE(kt::value_list<-1, 1u>.sort() == kt::value_list<-1, 1u>);
+    REQUIRE(kt::value_list<2u, -3L, 0, -1>.sort() == kt::value_list<-3L, -1, 0, 2u>);
+    REQUIRE(kt::value_list<2, 1, 2, 3, 1>.unique() == kt::value_list<2, 1, 3>);
+    REQUIRE(kt::value_list<1, 1u>.unique() == kt::value_list<1, 1u>);
+}
+
+TEST_CASE("value_list converts to arrays, sequences, and type lists", "[conversions]") {
+    constexpr auto arr = kt::value_list<1, 2, 3>.to_array();
+    REQUIRE(arr == std::array<int, 3> { 1, 2, 3 });
+    REQUIRE(kt::value_list<>.to_array(kt::tag<long>).empty());
+    REQUIRE(std::is_same_v<decltype(kt::value_list<1, 2>.to_sequence()), std::integer_sequence<int, 1, 2>>);
+    REQUIRE(std::is_same_v<decltype(kt::value_list<>.to_sequence(kt::tag<size_t>)), std::index_sequence<>>);
+    REQUIRE(kt::to_value_list(std::index_sequence<0, 1>()) == kt::value_list<size_t(0), size_t(1)>);
+
+    REQUIRE(kt::value_list<1, 'a'>.to_type_list() == kt::type_list<kt::value_t<1>, kt::value_t<'a'>>);
+    REQUIRE(kt::to_value_list(kt::value_list<1, 'a'>.to_type_list()) == kt::value_list<1, 'a'>);
+    REQUIRE(kt::to_value_list(kt::type_list<kt::index_t<2>, kt::index_t<5>>) == kt::value_list<size_t(2), size_t(5)>);
+}
@@ -0,0 +1,38 @@
+/*
+MIT License
+
+Copyright (c) 2023 Kieran Hsieh
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+#include <kt/visit.hpp>
+#include <catch2/catch_test_macros.hpp>
+
+TEST_CASE("visit_at calls the callable with the tag at a runtime index", "[visit]") {
+    static constexpr auto tl = kt::type_list<char, int, double>;
+    for(size_t i = 0; i < tl.size(); ++i) {
+        const size_t size = kt::visit_at(tl, i, [](auto t) { return sizeof(kt::from_tag_t<decltype(t)>); });
+        REQUIRE(size == (i == 0 ? sizeof(char) : i == 1 ? sizeof(int) : sizeof(double)));
+    }
+
+    size_t visited    = kt::npos;
+    const auto record = [&visited](auto t) { visited = tl.index_of(t); };
+    kt::visit_at(tl, 2, record);
+    REQUIRE(visited == 2);
+}